@@ -36,14 +36,15 @@ const char* const kSourceCode =
     "undefined\n"
     "void\n";
 
-const SourceCode& NewSourceCodeForBuildIn(Zone* zone) {
-  SourceCode::Factory source_code_factory(zone);
+const SourceCode& NewSourceCodeForBuildIn(
+    Zone* zone,
+    SourceCode::Factory* source_code_factory) {
   const auto& text16 = base::UTF8ToUTF16(kSourceCode);
   const auto size = text16.size() * sizeof(base::char16);
   auto* data = static_cast<base::char16*>(zone->Allocate(size));
   ::memcpy(data, text16.data(), size);
-  return source_code_factory.New(base::FilePath(),
-                                 base::StringPiece16(data, text16.size()));
+  return source_code_factory->New(base::FilePath(),
+                                  base::StringPiece16(data, text16.size()));
 }
 
 }  // namespace
@@ -74,6 +75,7 @@ class BuiltInWorld::Private final {
   // |ast::NodeFactory| constructor takes |zone_|.
   ast::NodeFactory node_factory_;
   const std::vector<ast::TokenKind> primitive_types_;
+  SourceCode::Factory source_code_factory_;
   const SourceCode& source_code_;
 
   // Mapping from known type name to type AST.
@@ -89,7 +91,8 @@ BuiltInWorld::Private::Private()
                         ast::TokenKind::Number, ast::TokenKind::String,
                         ast::TokenKind::Symbol, ast::TokenKind::Undefined,
                         ast::TokenKind::Void}),
-      source_code_(NewSourceCodeForBuildIn(&zone_)) {
+      source_code_factory_(&zone_),
+      source_code_(NewSourceCodeForBuildIn(&zone_, &source_code_factory_)) {
   PopulateNameTable();
   RegisterTypes();
 }
@@ -41,13 +41,13 @@ std::vector<const Class*> ClassListFrom(const Args&... classes) {
   return std::vector<const Class*>{const_cast<const Class*>(&classes)...};
 }
 
-const SourceCode& NewSourceCode(Zone* zone) {
-  SourceCode::Factory source_code_factory(zone);
+const SourceCode& NewSourceCode(Zone* zone,
+                                SourceCode::Factory* source_code_factory) {
   const auto& text16 = base::UTF8ToUTF16(kSourceCode);
   const auto size = text16.size() * sizeof(base::char16);
   auto* data = static_cast<base::char16*>(zone->Allocate(size));
   ::memcpy(data, text16.data(), size);
-  const auto& source_code = source_code_factory.New(
+  const auto& source_code = source_code_factory->New(
       base::FilePath(), base::StringPiece16(data, text16.size()));
   return source_code;
 }
@@ -77,6 +77,7 @@ class ClassTreeBuilderTest : public AnalyzerTestBase {
   const std::unique_ptr<Context> context_;
   Zone zone_;
   ast::NodeFactory node_factory_;
+  SourceCode::Factory source_code_factory_;
   const SourceCode& source_code_;
 
   DISALLOW_COPY_AND_ASSIGN(ClassTreeBuilderTest);
@@ -86,7 +87,8 @@ ClassTreeBuilderTest::ClassTreeBuilderTest()
     : context_(NewContext()),
       zone_("ClassTreeBuilderTest"),
       node_factory_(&zone_),
-      source_code_(NewSourceCode(&zone_)) {}
+      source_code_factory_(&zone_),
+      source_code_(NewSourceCode(&zone_, &source_code_factory_)) {}
 
 std::string ClassTreeBuilderTest::GetErrors() const {
   std::ostringstream ostream;
@@ -16,7 +16,7 @@ namespace analyzer {
 // Properties
 //
 Properties::Properties(Zone* zone, const ast::Node& owner)
-    : computed_name_map_(zone), name_map_(zone), owner_(owner) {}
+    : computed_name_map_(zone), name_map_(zone), zone_(*zone), owner_(owner) {}
 
 Properties::~Properties() = default;
 
@@ -31,7 +31,8 @@ const Property* Properties::TryGet(const ast::Node& key) const {
     const auto& it = name_map_.find(ast::Name::IdOf(key));
     return it == name_map_.end() ? nullptr : it->second;
   }
-  const auto& string_key = key.range().GetString();
+  base::string16 buffer;
+  const auto& string_key = key.range().GetString(&buffer);
   const auto& it = computed_name_map_.find(string_key);
   return it == computed_name_map_.end() ? nullptr : it->second;
 }
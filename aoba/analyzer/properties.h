@@ -8,7 +8,7 @@
 #include "base/macros.h"
 #include "base/strings/string_piece.h"
 #include "aoba/base/memory/zone_allocated.h"
-#include "aoba/base/memory/zone_unordered_map.h"
+#include "aoba/base/memory/zone_flat_map.h"
 #include "aoba/base/memory/zone_vector.h"
 
 namespace aoba {
@@ -43,12 +43,13 @@ class Properties final : public ZoneAllocated {
 
   // TODO(eval1749): We should use another way to handle computed property
   // name.
-  ZoneUnorderedMap<base::StringPiece16,
-                   const Property*,
-                   base::StringPiece16Hash>
+  ZoneFlatMap<base::StringPiece16, const Property*, base::StringPiece16Hash>
       computed_name_map_;
 
-  ZoneUnorderedMap<int, const Property*> name_map_;
+  ZoneFlatMap<int, const Property*> name_map_;
+
+  // Holds widened keys of one byte source code.
+  Zone& zone_;
 
   // AST node which creates this |Properties|.
   const ast::Node& owner_;
@@ -2,10 +2,14 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <algorithm>
+
 #include "aoba/analyzer/properties_editor.h"
 
 #include "aoba/analyzer/values.h"
 #include "aoba/ast/tokens.h"
+#include "aoba/base/memory/zone.h"
+#include "aoba/base/source_code.h"
 
 namespace aoba {
 namespace analyzer {
@@ -20,7 +24,16 @@ void Properties::Editor::Add(Properties* properties, const Property& property) {
     DCHECK(result.second);
     return;
   }
-  const auto& string_key = property.key().range().GetString();
+  const auto& range = property.key().range();
+  base::string16 buffer;
+  auto string_key = range.GetString(&buffer);
+  if (range.source_code().is_one_byte()) {
+    // Widened key should live as long as |properties|.
+    auto* const data =
+        properties->zone_.AllocateObjects<base::char16>(buffer.size());
+    std::copy(buffer.begin(), buffer.end(), data);
+    string_key = base::StringPiece16(data, buffer.size());
+  }
   const auto& result =
       properties->computed_name_map_.emplace(string_key, &property);
   DCHECK(result.second);
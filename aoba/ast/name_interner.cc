@@ -0,0 +1,177 @@
+// Copyright (c) 2016 Project Vogue. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <stdint.h>
+
+#include <algorithm>
+
+#include "aoba/ast/name_interner.h"
+
+#include "base/logging.h"
+#include "base/memory/singleton.h"
+#include "base/strings/utf_string_conversions.h"
+#include "aoba/ast/tokens.h"
+
+namespace aoba {
+namespace ast {
+
+namespace {
+
+struct PredefinedName {
+  const char* name;
+  size_t length;
+  TokenKind kind;
+};
+
+const PredefinedName kPredefinedNames[] = {
+#define V(name, camel, upper) {#name, sizeof(#name) - 1, TokenKind::camel},
+    FOR_EACH_JAVASCRIPT_KEYWORD(V)
+    FOR_EACH_JAVASCRIPT_KNOWN_WORD(V)
+#undef V
+#define V(name, camel, syntax) \
+  {"@" #name, sizeof("@" #name) - 1, TokenKind::At##camel},
+    FOR_EACH_JSDOC_TAG_NAME(V)
+#undef V
+};
+
+// FNV-1a hash of |name| from |seed|. Hash values of ASCII names in one byte
+// and two byte representations are equal.
+template <typename Char>
+uint32_t HashName(const Char* name, size_t length, uint32_t seed) {
+  auto hash = seed;
+  for (auto* runner = name; runner != name + length; ++runner) {
+    hash ^= static_cast<uint32_t>(*runner);
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+size_t ShardIndexOf(base::StringPiece16 name, size_t number_of_shards) {
+  // Low bits of hash value are used by |std::unordered_map| in shard.
+  return (base::StringPiece16Hash()(name) >> 8) % number_of_shards;
+}
+
+}  // namespace
+
+//
+// NameInterner::PredefinedNameTable
+// A perfect hash table of keywords, known words and JSDoc tag names. We
+// search a seed of |HashName()| which maps each predefined name to its own
+// slot, when the table is constructed.
+//
+class NameInterner::PredefinedNameTable final {
+ public:
+  PredefinedNameTable();
+  ~PredefinedNameTable() = default;
+
+  // Returns id of |name| if |name| is a predefined name, or zero.
+  template <typename Char>
+  int Find(const Char* name, size_t length) const;
+
+ private:
+  static const int kSlotBits = 10;
+
+  static size_t SlotIndexOf(uint32_t hash) { return hash >> (32 - kSlotBits); }
+
+  bool TryPopulate(uint32_t seed);
+
+  size_t max_length_ = 0;
+  uint32_t seed_ = 2166136261u;
+  // One origin index of |kPredefinedNames| or zero for empty slot.
+  std::array<uint8_t, 1 << kSlotBits> slots_;
+
+  DISALLOW_COPY_AND_ASSIGN(PredefinedNameTable);
+};
+
+NameInterner::PredefinedNameTable::PredefinedNameTable() {
+  static_assert(arraysize(kPredefinedNames) < 256,
+                "Slot value should fit in uint8_t.");
+  for (const auto& entry : kPredefinedNames)
+    max_length_ = std::max(max_length_, entry.length);
+  while (!TryPopulate(seed_))
+    ++seed_;
+}
+
+template <typename Char>
+int NameInterner::PredefinedNameTable::Find(const Char* name,
+                                            size_t length) const {
+  if (length > max_length_)
+    return 0;
+  const auto index = slots_[SlotIndexOf(HashName(name, length, seed_))];
+  if (index == 0)
+    return 0;
+  const auto& entry = kPredefinedNames[index - 1];
+  if (entry.length != length || !std::equal(name, name + length, entry.name))
+    return 0;
+  return static_cast<int>(entry.kind);
+}
+
+bool NameInterner::PredefinedNameTable::TryPopulate(uint32_t seed) {
+  slots_.fill(0);
+  auto index = 0;
+  for (const auto& entry : kPredefinedNames) {
+    ++index;
+    auto& slot = slots_[SlotIndexOf(HashName(entry.name, entry.length, seed))];
+    if (slot != 0)
+      return false;
+    slot = static_cast<uint8_t>(index);
+  }
+  return true;
+}
+
+//
+// NameInterner::Shard
+//
+NameInterner::Shard::Shard() : zone("NameInterner") {}
+NameInterner::Shard::~Shard() = default;
+
+//
+// NameInterner
+//
+NameInterner::NameInterner()
+    : last_id_(static_cast<int>(TokenKind::EndOfJsDocTagName)),
+      predefined_names_(new PredefinedNameTable()) {}
+
+NameInterner::~NameInterner() = default;
+
+// static
+NameInterner* NameInterner::GetInstance() {
+  // Name ids should be valid during process exit.
+  return base::Singleton<NameInterner,
+                         base::LeakySingletonTraits<NameInterner>>::get();
+}
+
+int NameInterner::Intern(base::StringPiece16 name) {
+  if (const auto id = predefined_names_->Find(name.data(), name.size()))
+    return id;
+  return InternInShard(name);
+}
+
+int NameInterner::Intern(base::StringPiece name) {
+  if (const auto id = predefined_names_->Find(name.data(), name.size()))
+    return id;
+  // Most of names are short enough to widen on stack.
+  const size_t kBufferSize = 64;
+  if (name.size() > kBufferSize)
+    return InternInShard(base::StringPiece16(base::ASCIIToUTF16(name)));
+  base::char16 buffer[kBufferSize];
+  std::copy(name.begin(), name.end(), buffer);
+  return InternInShard(base::StringPiece16(buffer, name.size()));
+}
+
+int NameInterner::InternInShard(base::StringPiece16 name) {
+  auto& shard = shards_[ShardIndexOf(name, kNumberOfShards)];
+  base::AutoLock lock(shard.lock);
+  const auto& it = shard.map.find(name);
+  if (it != shard.map.end())
+    return it->second;
+  auto* const data = shard.zone.AllocateObjects<base::char16>(name.size());
+  std::copy(name.begin(), name.end(), data);
+  const auto id = ++last_id_;
+  shard.map.emplace(base::StringPiece16(data, name.size()), id);
+  return id;
+}
+
+}  // namespace ast
+}  // namespace aoba
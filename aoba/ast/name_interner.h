@@ -0,0 +1,81 @@
+// Copyright (c) 2016 Project Vogue. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef AOBA_AST_NAME_INTERNER_H_
+#define AOBA_AST_NAME_INTERNER_H_
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <unordered_map>
+
+#include "base/macros.h"
+#include "base/strings/string_piece.h"
+#include "base/synchronization/lock.h"
+#include "aoba/ast/ast_export.h"
+#include "aoba/base/memory/zone.h"
+
+namespace base {
+template <typename T>
+struct DefaultSingletonTraits;
+}
+
+namespace aoba {
+namespace ast {
+
+//
+// NameInterner
+// Process-wide thread safe table of name ids. Keywords, known words and
+// JSDoc tag names have ids of |TokenKind|, and other names get dense ids
+// after them in order of interning. Names are copied into the interner, so
+// ids are stable after source code is destroyed.
+// Predefined names are looked up by a perfect hash table without locking.
+//
+class AOBA_AST_EXPORT NameInterner final {
+ public:
+  static NameInterner* GetInstance();
+
+  // Returns id of |name|.
+  int Intern(base::StringPiece16 name);
+
+  // Returns id of ASCII |name|, e.g. name in one byte source code.
+  int Intern(base::StringPiece name);
+
+ private:
+  friend struct base::DefaultSingletonTraits<NameInterner>;
+
+  class PredefinedNameTable;
+
+  // Names are distributed to shards by hash value to reduce lock contention
+  // on parsing multiple files on multiple threads.
+  struct Shard {
+    Shard();
+    ~Shard();
+
+    base::Lock lock;
+    std::unordered_map<base::StringPiece16, int, base::StringPiece16Hash> map;
+    // Holds characters of names.
+    Zone zone;
+  };
+
+  static const size_t kNumberOfShards = 16;
+
+  NameInterner();
+  ~NameInterner();
+
+  // Returns id of |name| not in |predefined_names_|.
+  int InternInShard(base::StringPiece16 name);
+
+  // The last name id assigned.
+  std::atomic<int> last_id_;
+  const std::unique_ptr<PredefinedNameTable> predefined_names_;
+  std::array<Shard, kNumberOfShards> shards_;
+
+  DISALLOW_COPY_AND_ASSIGN(NameInterner);
+};
+
+}  // namespace ast
+}  // namespace aoba
+
+#endif  // AOBA_AST_NAME_INTERNER_H_
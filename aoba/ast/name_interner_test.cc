@@ -0,0 +1,49 @@
+// Copyright (c) 2016 Project Vogue. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "aoba/ast/name_interner.h"
+
+#include "base/strings/string16.h"
+#include "aoba/ast/tokens.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace aoba {
+namespace ast {
+
+TEST(NameInternerTest, Intern) {
+  auto* const interner = NameInterner::GetInstance();
+  EXPECT_EQ(static_cast<int>(TokenKind::Function),
+            interner->Intern(base::StringPiece16(L"function")));
+  EXPECT_EQ(static_cast<int>(TokenKind::AtFileOverview),
+            interner->Intern(base::StringPiece16(L"@fileoverview")));
+
+  auto name = base::string16(L"NameInternerTest");
+  const auto id = interner->Intern(name);
+  EXPECT_LT(static_cast<int>(TokenKind::EndOfJsDocTagName), id);
+  name = L"Other";
+  EXPECT_NE(id, interner->Intern(name));
+  EXPECT_EQ(id, interner->Intern(base::StringPiece16(L"NameInternerTest")));
+}
+
+TEST(NameInternerTest, InternPredefined) {
+  auto* const interner = NameInterner::GetInstance();
+  EXPECT_EQ(static_cast<int>(TokenKind::Break),
+            interner->Intern(base::StringPiece("break")));
+  EXPECT_EQ(static_cast<int>(TokenKind::Yield),
+            interner->Intern(base::StringPiece("yield")));
+  EXPECT_EQ(static_cast<int>(TokenKind::AtParam),
+            interner->Intern(base::StringPiece("@param")));
+  EXPECT_EQ(static_cast<int>(TokenKind::AtParam),
+            interner->Intern(base::StringPiece16(L"@param")));
+
+  EXPECT_LT(static_cast<int>(TokenKind::EndOfJsDocTagName),
+            interner->Intern(base::StringPiece("breaks")));
+  EXPECT_LT(static_cast<int>(TokenKind::EndOfJsDocTagName),
+            interner->Intern(base::StringPiece("param")));
+  EXPECT_LT(static_cast<int>(TokenKind::EndOfJsDocTagName),
+            interner->Intern(base::StringPiece16(L"Function")));
+}
+
+}  // namespace ast
+}  // namespace aoba
@@ -17,8 +17,10 @@ namespace ast {
 //
 // Node
 //
-Node::Node(const SourceCodeRange& range, const Syntax& syntax, size_t arity)
-    : arity_(arity), range_(range), syntax_(syntax) {
+Node::Node(const SourceLocation& location,
+           const Syntax& syntax,
+           size_t arity)
+    : arity_(arity), location_(location), syntax_(syntax) {
   if (syntax_.is_variadic()) {
     DCHECK_GE(arity_, syntax.arity());
     return;
@@ -81,8 +83,10 @@ bool Node::Is(TokenKind kind) const {
 std::ostream& operator<<(std::ostream& ostream, const Node& node) {
   constexpr auto kMaxChars = 20;
   const auto& range = node.range();
+  base::string16 buffer;
   return ostream << node.syntax() << '(' << range << ", "
-                 << EscapedStringPiece16(range.GetString(), '|', kMaxChars)
+                 << EscapedStringPiece16(range.GetString(&buffer), '|',
+                                         kMaxChars)
                  << ')';
 }
 
@@ -10,6 +10,7 @@
 #include "base/macros.h"
 #include "aoba/ast/ast_export.h"
 #include "aoba/base/source_code_range.h"
+#include "aoba/base/source_location.h"
 
 namespace aoba {
 namespace ast {
@@ -45,11 +46,14 @@ class AOBA_AST_EXPORT Node final {
   // Returns |index|th child of this node.
   const Node& child_at(size_t index) const;
 
+  // Returns compact source code range of this node.
+  const SourceLocation& location() const { return location_; }
+
   // Returns source code of this node.
-  const SourceCode& source_code() const { return range_.source_code(); }
+  const SourceCode& source_code() const { return location_.source_code(); }
 
   // Returns source code range of this node.
-  const SourceCodeRange& range() const { return range_; }
+  SourceCodeRange range() const { return location_.ToRange(); }
 
   // Returns |Syntax| of this node.
   const Syntax& syntax() const { return syntax_; }
@@ -67,7 +71,7 @@ class AOBA_AST_EXPORT Node final {
   }
 
  protected:
-  Node(const SourceCodeRange& range, const Syntax& syntax, size_t arity);
+  Node(const SourceLocation& location, const Syntax& syntax, size_t arity);
 
  private:
   friend class NodeFactory;
@@ -78,8 +82,9 @@ class AOBA_AST_EXPORT Node final {
   // |syntax_.arity()| if |!syntax_.is_variadic()|.
   const size_t arity_;
 
-  // Range of source code where this node comes from.
-  const SourceCodeRange range_;
+  // Range of source code where this node comes from. We use |SourceLocation|
+  // rather than |SourceCodeRange| to reduce size of |Node|.
+  const SourceLocation location_;
 
   // The syntax of this node.
   const Syntax& syntax_;
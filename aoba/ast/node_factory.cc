@@ -2,7 +2,8 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
-#include <unordered_map>
+#include <algorithm>
+#include <utility>
 
 #include "aoba/ast/node_factory.h"
 
@@ -12,11 +13,14 @@
 #include "aoba/ast/expressions.h"
 #include "aoba/ast/jsdoc_syntaxes.h"
 #include "aoba/ast/literals.h"
+#include "aoba/ast/name_interner.h"
+#include "aoba/ast/node_list_builder.h"
 #include "aoba/ast/regexp.h"
 #include "aoba/ast/statements.h"
 #include "aoba/ast/syntax_factory.h"
 #include "aoba/ast/tokens.h"
 #include "aoba/ast/types.h"
+#include "aoba/base/source_code.h"
 
 namespace aoba {
 namespace ast {
@@ -45,73 +49,103 @@ void InitializeOperands(const Node** destination,
 
 }  // namespace
 
-//
-// NodeFactory::NameIdMap
-//
-class NodeFactory::NameIdMap {
- public:
-  NameIdMap();
-  ~NameIdMap();
-
-  int Register(base::StringPiece16 name);
-
- private:
-  void Populate();
-
-  std::unordered_map<base::StringPiece16, int, base::StringPiece16Hash> map_;
-  int last_id_ = 0;
-
-  DISALLOW_COPY_AND_ASSIGN(NameIdMap);
-};
-
-NodeFactory::NameIdMap::NameIdMap() {
-  Populate();
-}
-
-NodeFactory::NameIdMap::~NameIdMap() = default;
-
-void NodeFactory::NameIdMap::Populate() {
-  last_id_ = static_cast<int>(TokenKind::StartOfKeyword);
-#define V(name, camel, upper) Register(base::StringPiece16(L## #name));
-  FOR_EACH_JAVASCRIPT_KEYWORD(V)
-#undef V
-
-  last_id_ = static_cast<int>(TokenKind::StartOfKnownWord);
-#define V(name, camel, upper) Register(base::StringPiece16(L## #name));
-  FOR_EACH_JAVASCRIPT_KNOWN_WORD(V)
-#undef V
-
-  last_id_ = static_cast<int>(TokenKind::StartOfJsDocTagName);
-#define V(name, camel, upper) Register(base::StringPiece16(L##"@" #name));
-  FOR_EACH_JSDOC_TAG_NAME(V)
-#undef V
-}
-
-int NodeFactory::NameIdMap::Register(base::StringPiece16 name) {
-  const auto& it = map_.find(name);
-  if (it != map_.end())
-    return it->second;
-  ++last_id_;
-  map_.emplace(name, last_id_);
-  return last_id_;
-}
-
 //
 // NodeFactory implementations
 //
 NodeFactory::NodeFactory(Zone* zone)
-    : name_id_map_(new NameIdMap()),
-      syntax_factory_(new SyntaxFactory(zone)),
+    : syntax_zone_("NodeFactory.Syntax"),
+      syntax_factory_(new SyntaxFactory(&syntax_zone_)),
       zone_(*zone) {}
 
 NodeFactory::~NodeFactory() = default;
 
+Zone::Checkpoint NodeFactory::CreateCheckpoint() const {
+  return zone_.CreateCheckpoint();
+}
+
+// Nodes allocated after |checkpoint| in |node| tree are saved into vectors,
+// and are re-created in one block after rewinding. Since a child is created
+// before its parent, nodes allocated before |checkpoint| have no child
+// allocated after |checkpoint|.
+const Node& NodeFactory::RewindKeeping(const Zone::Checkpoint& checkpoint,
+                                       const Node& node) {
+  // Collect nodes to copy in address order. Shared nodes are visited more
+  // than once, but they are rare.
+  std::vector<const Node*> nodes;
+  std::vector<const Node*> stack;
+  if (zone_.IsAllocatedAfter(checkpoint, &node))
+    stack.push_back(&node);
+  while (!stack.empty()) {
+    const auto& runner = *stack.back();
+    stack.pop_back();
+    nodes.push_back(&runner);
+    for (size_t index = 0; index < runner.arity(); ++index) {
+      const auto& child = runner.child_at(index);
+      if (zone_.IsAllocatedAfter(checkpoint, &child))
+        stack.push_back(&child);
+    }
+  }
+  std::sort(nodes.begin(), nodes.end());
+  nodes.erase(std::unique(nodes.begin(), nodes.end()), nodes.end());
+
+  // Save copied nodes. A child copied is represented by its index in |nodes|
+  // with null pointer.
+  struct Copy {
+    SourceLocation location;
+    const Syntax* syntax;
+    size_t arity;
+    size_t offset;
+  };
+  const auto index_of = [&nodes](const Node& node) {
+    return static_cast<size_t>(
+        std::lower_bound(nodes.begin(), nodes.end(), &node) - nodes.begin());
+  };
+  std::vector<Copy> copies;
+  std::vector<std::pair<const Node*, size_t>> children;
+  copies.reserve(nodes.size());
+  auto size = size_t{0};
+  for (const auto* const original : nodes) {
+    copies.push_back(Copy{original->location(), &original->syntax(),
+                          original->arity(), size});
+    size += sizeof(Node) + sizeof(Node*) * original->arity();
+    for (size_t index = 0; index < original->arity(); ++index) {
+      const auto& child = original->child_at(index);
+      if (zone_.IsAllocatedAfter(checkpoint, &child))
+        children.emplace_back(nullptr, index_of(child));
+      else
+        children.emplace_back(&child, 0);
+    }
+  }
+  const auto root_index = index_of(node);
+
+  zone_.Rewind(checkpoint);
+  if (copies.empty())
+    return node;
+
+  auto* const block = static_cast<char*>(zone_.Allocate(size));
+  auto child = children.begin();
+  for (const auto& copy : copies) {
+    auto* const new_node = new (block + copy.offset)
+        Node(copy.location, *copy.syntax, copy.arity);
+    new_node->nodes_[0] = nullptr;
+    for (size_t index = 0; index < copy.arity; ++index) {
+      new_node->nodes_[index] =
+          child->first ? child->first
+                       : reinterpret_cast<const Node*>(
+                             block + copies[child->second].offset);
+      ++child;
+    }
+  }
+  return *reinterpret_cast<const Node*>(block + copies[root_index].offset);
+}
+
 const Node& NodeFactory::NewVariadicNode(
     const SourceCodeRange& range,
     const Syntax& tag,
     const std::vector<const Node*>& nodes) {
   const auto size = nodes.size();
-  auto* const node = new (AllocateNode(&zone_, size)) Node(range, tag, size);
+  auto* const node = new (AllocateNode(&zone_, size))
+      Node(SourceLocation(range), tag, size);
   auto** runner = &node->nodes_[0];
   for (const auto* child : nodes) {
     *runner = child;
@@ -126,7 +160,8 @@ const Node& NodeFactory::NewVariadicNode(
     const Node& node0,
     const std::vector<const Node*>& nodes) {
   const auto size = nodes.size() + 1;
-  auto* const node = new (AllocateNode(&zone_, size)) Node(range, tag, size);
+  auto* const node = new (AllocateNode(&zone_, size))
+      Node(SourceLocation(range), tag, size);
   auto** runner = &node->nodes_[0];
   *runner = &node0;
   ++runner;
@@ -137,13 +172,30 @@ const Node& NodeFactory::NewVariadicNode(
   return *node;
 }
 
+const Node& NodeFactory::NewVariadicNode(const SourceCodeRange& range,
+                                         const Syntax& tag,
+                                         NodeListBuilder* nodes) {
+  auto& node = NewVariadicNode(range, tag, nodes->nodes_);
+  nodes->nodes_.clear();
+  return node;
+}
+
+const Node& NodeFactory::NewVariadicNode(const SourceCodeRange& range,
+                                         const Syntax& tag,
+                                         const Node& node0,
+                                         NodeListBuilder* nodes) {
+  auto& node = NewVariadicNode(range, tag, node0, nodes->nodes_);
+  nodes->nodes_.clear();
+  return node;
+}
+
 template <typename... Types>
 const Node& NodeFactory::NewNode(const SourceCodeRange& range,
                                  const Syntax& tag,
                                  const Types&... operands) {
   const auto number_of_operands = sizeof...(operands);
   auto* const node = new (AllocateNode(&zone_, number_of_operands))
-      Node(range, tag, number_of_operands);
+      Node(SourceLocation(range), tag, number_of_operands);
   InitializeOperands(&node->nodes_[0], operands...);
   return *node;
 }
@@ -160,16 +212,31 @@ const Node& NodeFactory::NewExterns(
   return NewVariadicNode(range, syntax_factory_->NewExterns(), statements);
 }
 
+const Node& NodeFactory::NewExterns(const SourceCodeRange& range,
+                                    NodeListBuilder* statements) {
+  return NewVariadicNode(range, syntax_factory_->NewExterns(), statements);
+}
+
 const Node& NodeFactory::NewModule(const SourceCodeRange& range,
                                    const std::vector<const Node*>& statements) {
   return NewVariadicNode(range, syntax_factory_->NewModule(), statements);
 }
 
+const Node& NodeFactory::NewModule(const SourceCodeRange& range,
+                                   NodeListBuilder* statements) {
+  return NewVariadicNode(range, syntax_factory_->NewModule(), statements);
+}
+
 const Node& NodeFactory::NewScript(const SourceCodeRange& range,
                                    const std::vector<const Node*>& statements) {
   return NewVariadicNode(range, syntax_factory_->NewScript(), statements);
 }
 
+const Node& NodeFactory::NewScript(const SourceCodeRange& range,
+                                   NodeListBuilder* statements) {
+  return NewVariadicNode(range, syntax_factory_->NewScript(), statements);
+}
+
 // Tokens
 const Node& NodeFactory::NewComment(const SourceCodeRange& range) {
   return NewNode(range, syntax_factory_->NewComment());
@@ -186,13 +253,24 @@ const Node& NodeFactory::NewInvalid(const SourceCodeRange& range,
 
 const Node& NodeFactory::NewName(const SourceCodeRange& range,
                                  TokenKind name_id) {
-  DCHECK_EQ(name_id, TokenKind::YieldStar);
   return NewNode(range, syntax_factory_->NewName(static_cast<int>(name_id)));
 }
 
 const Node& NodeFactory::NewName(const SourceCodeRange& range) {
-  const auto name_id = name_id_map_->Register(range.GetString());
-  return NewNode(range, syntax_factory_->NewName(name_id));
+  return NewName(range, NameIdOf(range));
+}
+
+// static
+TokenKind NodeFactory::NameIdOf(const SourceCodeRange& range) {
+  const auto& source_code = range.source_code();
+  // Avoid widening names in one byte source code.
+  base::string16 buffer;
+  const auto name_id =
+      source_code.is_one_byte()
+          ? NameInterner::GetInstance()->Intern(
+                source_code.GetOneByteString(range.start(), range.end()))
+          : NameInterner::GetInstance()->Intern(range.GetString(&buffer));
+  return static_cast<TokenKind>(name_id);
 }
 
 const Node& NodeFactory::NewPunctuator(const SourceCodeRange& range,
@@ -311,6 +389,12 @@ const Node& NodeFactory::NewArrayInitializer(
                          elements);
 }
 
+const Node& NodeFactory::NewArrayInitializer(const SourceCodeRange& range,
+                                             NodeListBuilder* elements) {
+  return NewVariadicNode(range, syntax_factory_->NewArrayInitializer(),
+                         elements);
+}
+
 const Node& NodeFactory::NewAssignmentExpression(const SourceCodeRange& range,
                                                  const Node& op,
                                                  const Node& lhs,
@@ -336,6 +420,13 @@ const Node& NodeFactory::NewCallExpression(
                          argument_list);
 }
 
+const Node& NodeFactory::NewCallExpression(const SourceCodeRange& range,
+                                           const Node& callee,
+                                           NodeListBuilder* argument_list) {
+  return NewVariadicNode(range, syntax_factory_->NewCallExpression(), callee,
+                         argument_list);
+}
+
 const Node& NodeFactory::NewCommaExpression(
     const SourceCodeRange& range,
     const std::vector<const Node*>& expressions) {
@@ -343,6 +434,12 @@ const Node& NodeFactory::NewCommaExpression(
                          expressions);
 }
 
+const Node& NodeFactory::NewCommaExpression(const SourceCodeRange& range,
+                                            NodeListBuilder* expressions) {
+  return NewVariadicNode(range, syntax_factory_->NewCommaExpression(),
+                         expressions);
+}
+
 const Node& NodeFactory::NewComputedMemberExpression(
     const SourceCodeRange& range,
     const Node& expression,
@@ -390,6 +487,13 @@ const Node& NodeFactory::NewNewExpression(
                          argument_list);
 }
 
+const Node& NodeFactory::NewNewExpression(const SourceCodeRange& range,
+                                          const Node& callee,
+                                          NodeListBuilder* argument_list) {
+  return NewVariadicNode(range, syntax_factory_->NewNewExpression(), callee,
+                         argument_list);
+}
+
 const Node& NodeFactory::NewObjectInitializer(
     const SourceCodeRange& range,
     const std::vector<const Node*>& properties) {
@@ -397,6 +501,12 @@ const Node& NodeFactory::NewObjectInitializer(
                          properties);
 }
 
+const Node& NodeFactory::NewObjectInitializer(const SourceCodeRange& range,
+                                              NodeListBuilder* properties) {
+  return NewVariadicNode(range, syntax_factory_->NewObjectInitializer(),
+                         properties);
+}
+
 const Node& NodeFactory::NewParameterList(
     const SourceCodeRange& range,
     const std::vector<const Node*>& parameters) {
@@ -550,6 +660,12 @@ const Node& NodeFactory::NewBlockStatement(
                          statements);
 }
 
+const Node& NodeFactory::NewBlockStatement(const SourceCodeRange& range,
+                                           NodeListBuilder* statements) {
+  return NewVariadicNode(range, syntax_factory_->NewBlockStatement(),
+                         statements);
+}
+
 const Node& NodeFactory::NewBreakStatement(const SourceCodeRange& range,
                                            const Node& label) {
   return NewNode(range, syntax_factory_->NewBreakStatement(), label);
@@ -20,6 +20,7 @@ class SourceCodeRange;
 namespace ast {
 
 class Node;
+class NodeListBuilder;
 class Syntax;
 class SyntaxFactory;
 
@@ -31,18 +32,37 @@ class AOBA_AST_EXPORT NodeFactory final {
   explicit NodeFactory(Zone* zone);
   ~NodeFactory();
 
+  // Returns a checkpoint for |RewindKeeping()|.
+  Zone::Checkpoint CreateCheckpoint() const;
+
+  // Releases nodes created after |checkpoint| and returns a copy of |node|
+  // tree. Other nodes created after |checkpoint| must not be used after this
+  // call. This function is used for reclaiming nodes of abandoned speculative
+  // parsing.
+  // Note: Only nodes of |node| tree survive. Nothing else, e.g. JsDoc nodes
+  // kept by lexer, should be allocated in the node zone between
+  // |CreateCheckpoint()| and this call.
+  const Node& RewindKeeping(const Zone::Checkpoint& checkpoint,
+                            const Node& node);
+
   const Node& NewTuple(const SourceCodeRange& range,
                        const std::vector<const Node*>& nodes);
 
   // Compilation unit factory members
   const Node& NewExterns(const SourceCodeRange& range,
                          const std::vector<const Node*>& statements);
+  const Node& NewExterns(const SourceCodeRange& range,
+                         NodeListBuilder* statements);
 
   const Node& NewModule(const SourceCodeRange& range,
                         const std::vector<const Node*>& statements);
+  const Node& NewModule(const SourceCodeRange& range,
+                        NodeListBuilder* statements);
 
   const Node& NewScript(const SourceCodeRange& range,
                         const std::vector<const Node*>& statements);
+  const Node& NewScript(const SourceCodeRange& range,
+                        NodeListBuilder* statements);
 
   //
   // Nodes factory members
@@ -52,10 +72,13 @@ class AOBA_AST_EXPORT NodeFactory final {
   const Node& NewInvalid(const SourceCodeRange& range, int error_code);
 
   // Returns new |Name| token with specified |name_id|. This function is used
-  // for constructing pseudo name "yield*".
+  // for constructing pseudo name "yield*" and names interned by |Lexer|.
   const Node& NewName(const SourceCodeRange& range, TokenKind name_id);
   const Node& NewName(const SourceCodeRange& range);
 
+  // Returns name id of source text in |range|.
+  static TokenKind NameIdOf(const SourceCodeRange& range);
+
   const Node& NewPunctuator(const SourceCodeRange& range, TokenKind kind);
   const Node& NewRegExpSource(const SourceCodeRange& range);
 
@@ -122,6 +145,8 @@ class AOBA_AST_EXPORT NodeFactory final {
   // Expression factory members
   const Node& NewArrayInitializer(const SourceCodeRange& range,
                                   const std::vector<const Node*>& elements);
+  const Node& NewArrayInitializer(const SourceCodeRange& range,
+                                  NodeListBuilder* elements);
 
   const Node& NewAssignmentExpression(const SourceCodeRange& range,
                                       const Node& op,
@@ -136,9 +161,14 @@ class AOBA_AST_EXPORT NodeFactory final {
   const Node& NewCallExpression(const SourceCodeRange& range,
                                 const Node& callee,
                                 const std::vector<const Node*>& argument_list);
+  const Node& NewCallExpression(const SourceCodeRange& range,
+                                const Node& callee,
+                                NodeListBuilder* argument_list);
 
   const Node& NewCommaExpression(const SourceCodeRange& range,
                                  const std::vector<const Node*>& expressions);
+  const Node& NewCommaExpression(const SourceCodeRange& range,
+                                 NodeListBuilder* expressions);
 
   // expression '[' expression ']'
   const Node& NewComputedMemberExpression(const SourceCodeRange& range,
@@ -157,9 +187,14 @@ class AOBA_AST_EXPORT NodeFactory final {
   const Node& NewNewExpression(const SourceCodeRange& range,
                                const Node& expression,
                                const std::vector<const Node*>& argument_list);
+  const Node& NewNewExpression(const SourceCodeRange& range,
+                               const Node& expression,
+                               NodeListBuilder* argument_list);
 
   const Node& NewObjectInitializer(const SourceCodeRange& range,
                                    const std::vector<const Node*>& elements);
+  const Node& NewObjectInitializer(const SourceCodeRange& range,
+                                   NodeListBuilder* elements);
 
   const Node& NewMemberExpression(const SourceCodeRange& range,
                                   const Node& expression,
@@ -246,6 +281,8 @@ class AOBA_AST_EXPORT NodeFactory final {
   // Statement factory members
   const Node& NewBlockStatement(const SourceCodeRange& range,
                                 const std::vector<const Node*>& statements);
+  const Node& NewBlockStatement(const SourceCodeRange& range,
+                                NodeListBuilder* statements);
 
   const Node& NewBreakStatement(const SourceCodeRange& range,
                                 const Node& label);
@@ -391,7 +428,7 @@ class AOBA_AST_EXPORT NodeFactory final {
   const Node& NewVoidType(const SourceCodeRange& range);
 
  private:
-  class NameIdMap;
+  friend class NodeListBuilder;
 
   const Node& NewVariadicNode(const SourceCodeRange& range,
                               const Syntax& tag,
@@ -402,15 +439,29 @@ class AOBA_AST_EXPORT NodeFactory final {
                               const Node& node0,
                               const std::vector<const Node*>& nodes);
 
+  const Node& NewVariadicNode(const SourceCodeRange& range,
+                              const Syntax& tag,
+                              NodeListBuilder* nodes);
+
+  const Node& NewVariadicNode(const SourceCodeRange& range,
+                              const Syntax& tag,
+                              const Node& node0,
+                              NodeListBuilder* nodes);
+
   template <typename... Types>
   const Node& NewNode(const SourceCodeRange& range,
                       const Syntax& tag,
                       const Types&... operands);
 
-  std::unique_ptr<NameIdMap> name_id_map_;
+  // Syntaxes are cached by |SyntaxFactory|, so they should be allocated in
+  // separate zone to survive |RewindKeeping()|.
+  Zone syntax_zone_;
   std::unique_ptr<SyntaxFactory> syntax_factory_;
   Zone& zone_;
 
+  // Vectors of child nodes lent to |NodeListBuilder|.
+  std::vector<std::vector<const Node*>> free_node_lists_;
+
   DISALLOW_COPY_AND_ASSIGN(NodeFactory);
 };
 
@@ -0,0 +1,42 @@
+// Copyright (c) 2016 Project Vogue. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <utility>
+
+#include "aoba/ast/node_list_builder.h"
+
+#include "aoba/ast/node.h"
+#include "aoba/ast/node_factory.h"
+
+namespace aoba {
+namespace ast {
+
+//
+// NodeListBuilder
+//
+NodeListBuilder::NodeListBuilder(NodeFactory* factory) : factory_(*factory) {
+  auto& free_lists = factory_.free_node_lists_;
+  if (free_lists.empty())
+    return;
+  nodes_ = std::move(free_lists.back());
+  free_lists.pop_back();
+}
+
+NodeListBuilder::~NodeListBuilder() {
+  nodes_.clear();
+  factory_.free_node_lists_.push_back(std::move(nodes_));
+}
+
+const Node& NodeListBuilder::front() const {
+  DCHECK(!empty());
+  return *nodes_.front();
+}
+
+void NodeListBuilder::push_back(const Node* node) {
+  DCHECK(node);
+  nodes_.push_back(node);
+}
+
+}  // namespace ast
+}  // namespace aoba
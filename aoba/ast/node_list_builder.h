@@ -0,0 +1,50 @@
+// Copyright (c) 2016 Project Vogue. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef AOBA_AST_NODE_LIST_BUILDER_H_
+#define AOBA_AST_NODE_LIST_BUILDER_H_
+
+#include <vector>
+
+#include "base/logging.h"
+#include "base/macros.h"
+#include "aoba/ast/ast_export.h"
+
+namespace aoba {
+
+namespace ast {
+
+class Node;
+class NodeFactory;
+
+//
+// NodeListBuilder
+// Collects child nodes of variadic node. |NodeFactory| allocates the variadic
+// node with exact number of child nodes, and lends vectors to builders for
+// reusing their capacity, since builders are nested while parsing.
+//
+class AOBA_AST_EXPORT NodeListBuilder final {
+ public:
+  explicit NodeListBuilder(NodeFactory* factory);
+  ~NodeListBuilder();
+
+  bool empty() const { return nodes_.empty(); }
+  size_t size() const { return nodes_.size(); }
+
+  const Node& front() const;
+  void push_back(const Node* node);
+
+ private:
+  friend class NodeFactory;
+
+  NodeFactory& factory_;
+  std::vector<const Node*> nodes_;
+
+  DISALLOW_COPY_AND_ASSIGN(NodeListBuilder);
+};
+
+}  // namespace ast
+}  // namespace aoba
+
+#endif  // AOBA_AST_NODE_LIST_BUILDER_H_
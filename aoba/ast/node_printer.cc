@@ -21,9 +21,10 @@ std::ostream& operator<<(std::ostream& ostream,
   const auto& node = *printable.node;
   const auto& range = node.range();
   const auto delimiter = printable.delimiter;
+  base::string16 buffer;
   if (delimiter == 0)
-    return ostream << base::UTF16ToUTF8(range.GetString());
-  return ostream << EscapedStringPiece16(range.GetString(), delimiter);
+    return ostream << base::UTF16ToUTF8(range.GetString(&buffer));
+  return ostream << EscapedStringPiece16(range.GetString(&buffer), delimiter);
 }
 
 }  // namespace ast
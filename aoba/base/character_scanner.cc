@@ -0,0 +1,202 @@
+// Copyright (c) 2016 Project Vogue. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "aoba/base/character_scanner.h"
+
+#include "build/build_config.h"
+
+#if defined(ARCH_CPU_X86_FAMILY)
+#include <emmintrin.h>
+#define AOBA_SCANNER_USE_SSE2 1
+#endif
+
+#if defined(COMPILER_MSVC)
+#include <intrin.h>
+#endif
+
+namespace aoba {
+
+namespace {
+
+const base::char16 kLineSeparator = 0x2028;
+const base::char16 kParagraphSeparator = 0x2029;
+
+#if defined(AOBA_SCANNER_USE_SSE2)
+int CountTrailingZeros(uint32_t bits) {
+#if defined(COMPILER_MSVC)
+  unsigned long index;
+  _BitScanForward(&index, bits);
+  return static_cast<int>(index);
+#else
+  return __builtin_ctz(bits);
+#endif
+}
+
+__m128i Load(const void* pointer) {
+  return _mm_loadu_si128(reinterpret_cast<const __m128i*>(pointer));
+}
+
+__m128i Equal(const uint8_t*, __m128i vector, int char_code) {
+  return _mm_cmpeq_epi8(vector, _mm_set1_epi8(static_cast<char>(char_code)));
+}
+
+__m128i Equal(const base::char16*, __m128i vector, int char_code) {
+  return _mm_cmpeq_epi16(vector,
+                         _mm_set1_epi16(static_cast<int16_t>(char_code)));
+}
+#endif
+
+// A matcher provides |Match(const T*)|, which returns true if character at
+// the pointer is what we find, and |Match(const T*, __m128i)|, which returns
+// vector of all one bits for matched characters in the vector loaded from
+// the pointer.
+// Returns the first character matched by |matcher| in |[start, end)|.
+template <typename Matcher, typename T>
+const T* Find(const Matcher& matcher, const T* start, const T* end) {
+  auto* runner = start;
+#if defined(AOBA_SCANNER_USE_SSE2)
+  const auto kCharsPerVector = static_cast<int>(sizeof(__m128i) / sizeof(T));
+  for (; end - runner >= kCharsPerVector; runner += kCharsPerVector) {
+    const auto bits = static_cast<uint32_t>(
+        _mm_movemask_epi8(matcher.Match(runner, Load(runner))));
+    if (bits)
+      return runner + CountTrailingZeros(bits) / sizeof(T);
+  }
+#endif
+  for (; runner < end; ++runner) {
+    if (matcher.Match(runner))
+      return runner;
+  }
+  return end;
+}
+
+class BlockCommentEndMatcher final {
+ public:
+  template <typename T>
+  bool Match(const T* pointer) const {
+    return pointer[0] == '/' && pointer[-1] == '*';
+  }
+
+#if defined(AOBA_SCANNER_USE_SSE2)
+  template <typename T>
+  __m128i Match(const T* pointer, __m128i vector) const {
+    return _mm_and_si128(Equal(pointer, vector, '/'),
+                         Equal(pointer, Load(pointer - 1), '*'));
+  }
+#endif
+};
+
+class CharMatcher final {
+ public:
+  explicit CharMatcher(int char_code) : char_code_(char_code) {}
+
+  template <typename T>
+  bool Match(const T* pointer) const {
+    return *pointer == char_code_;
+  }
+
+#if defined(AOBA_SCANNER_USE_SSE2)
+  template <typename T>
+  __m128i Match(const T* pointer, __m128i vector) const {
+    return Equal(pointer, vector, char_code_);
+  }
+#endif
+
+ private:
+  const int char_code_;
+};
+
+class LineTerminatorMatcher final {
+ public:
+  bool Match(const uint8_t* pointer) const {
+    return *pointer == '\n' || *pointer == '\r';
+  }
+
+  bool Match(const base::char16* pointer) const {
+    return *pointer == '\n' || *pointer == '\r' ||
+           *pointer == kLineSeparator || *pointer == kParagraphSeparator;
+  }
+
+#if defined(AOBA_SCANNER_USE_SSE2)
+  __m128i Match(const uint8_t* pointer, __m128i vector) const {
+    return _mm_or_si128(Equal(pointer, vector, '\n'),
+                        Equal(pointer, vector, '\r'));
+  }
+
+  __m128i Match(const base::char16* pointer, __m128i vector) const {
+    return _mm_or_si128(
+        _mm_or_si128(Equal(pointer, vector, '\n'),
+                     Equal(pointer, vector, '\r')),
+        _mm_or_si128(Equal(pointer, vector, kLineSeparator),
+                     Equal(pointer, vector, kParagraphSeparator)));
+  }
+#endif
+};
+
+class NonSpaceMatcher final {
+ public:
+  template <typename T>
+  bool Match(const T* pointer) const {
+    return *pointer != ' ' && *pointer != '\t';
+  }
+
+#if defined(AOBA_SCANNER_USE_SSE2)
+  template <typename T>
+  __m128i Match(const T* pointer, __m128i vector) const {
+    const auto spaces = _mm_or_si128(Equal(pointer, vector, ' '),
+                                     Equal(pointer, vector, '\t'));
+    return _mm_xor_si128(spaces, _mm_cmpeq_epi8(spaces, spaces));
+  }
+#endif
+};
+
+template <typename T>
+const T* FindBlockCommentEndInternal(const T* start, const T* end) {
+  if (end - start < 2)
+    return end;
+  return Find(BlockCommentEndMatcher(), start + 1, end);
+}
+
+}  // namespace
+
+const uint8_t* FindBlockCommentEnd(const uint8_t* start, const uint8_t* end) {
+  return FindBlockCommentEndInternal(start, end);
+}
+
+const base::char16* FindBlockCommentEnd(const base::char16* start,
+                                        const base::char16* end) {
+  return FindBlockCommentEndInternal(start, end);
+}
+
+const uint8_t* FindChar(const uint8_t* start,
+                        const uint8_t* end,
+                        uint8_t char_code) {
+  return Find(CharMatcher(char_code), start, end);
+}
+
+const base::char16* FindChar(const base::char16* start,
+                             const base::char16* end,
+                             base::char16 char_code) {
+  return Find(CharMatcher(char_code), start, end);
+}
+
+const uint8_t* FindLineTerminator(const uint8_t* start, const uint8_t* end) {
+  return Find(LineTerminatorMatcher(), start, end);
+}
+
+const base::char16* FindLineTerminator(const base::char16* start,
+                                       const base::char16* end) {
+  return Find(LineTerminatorMatcher(), start, end);
+}
+
+const uint8_t* SkipSpaces(const uint8_t* start, const uint8_t* end) {
+  return Find(NonSpaceMatcher(), start, end);
+}
+
+const base::char16* SkipSpaces(const base::char16* start,
+                               const base::char16* end) {
+  return Find(NonSpaceMatcher(), start, end);
+}
+
+}  // namespace aoba
@@ -0,0 +1,54 @@
+// Copyright (c) 2016 Project Vogue. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef AOBA_BASE_CHARACTER_SCANNER_H_
+#define AOBA_BASE_CHARACTER_SCANNER_H_
+
+#include <stdint.h>
+
+#include "base/strings/string16.h"
+#include "aoba/base/base_export.h"
+
+namespace aoba {
+
+//
+// Character scanners
+// Find characters in one byte or UTF-16 source text. These functions examine
+// 16 bytes at once with SSE2 on x86, and fall back to a loop on other
+// platforms. Each function returns |end| if there is no such character.
+//
+
+// Returns pointer to "/" of the first "*/" in |[start, end)|.
+AOBA_BASE_EXPORT const uint8_t* FindBlockCommentEnd(const uint8_t* start,
+                                                    const uint8_t* end);
+AOBA_BASE_EXPORT const base::char16* FindBlockCommentEnd(
+    const base::char16* start,
+    const base::char16* end);
+
+// Returns pointer to the first |char_code| in |[start, end)|.
+AOBA_BASE_EXPORT const uint8_t* FindChar(const uint8_t* start,
+                                         const uint8_t* end,
+                                         uint8_t char_code);
+AOBA_BASE_EXPORT const base::char16* FindChar(const base::char16* start,
+                                              const base::char16* end,
+                                              base::char16 char_code);
+
+// Returns pointer to the first line terminator, LF, CR, U+2028 or U+2029, in
+// |[start, end)|.
+AOBA_BASE_EXPORT const uint8_t* FindLineTerminator(const uint8_t* start,
+                                                   const uint8_t* end);
+AOBA_BASE_EXPORT const base::char16* FindLineTerminator(
+    const base::char16* start,
+    const base::char16* end);
+
+// Returns pointer to the first character other than space and tab in
+// |[start, end)|.
+AOBA_BASE_EXPORT const uint8_t* SkipSpaces(const uint8_t* start,
+                                           const uint8_t* end);
+AOBA_BASE_EXPORT const base::char16* SkipSpaces(const base::char16* start,
+                                                const base::char16* end);
+
+}  // namespace aoba
+
+#endif  // AOBA_BASE_CHARACTER_SCANNER_H_
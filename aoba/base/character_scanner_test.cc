@@ -0,0 +1,104 @@
+// Copyright (c) 2016 Project Vogue. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <string>
+
+#include "aoba/base/character_scanner.h"
+
+#include "base/strings/utf_string_conversions.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace aoba {
+
+namespace {
+
+const uint8_t* Begin(const std::string& text) {
+  return reinterpret_cast<const uint8_t*>(text.data());
+}
+
+const uint8_t* End(const std::string& text) {
+  return Begin(text) + text.size();
+}
+
+// Returns offset of result of |FindBlockCommentEnd()| on one byte and UTF-16
+// |text| if both are same, otherwise -1.
+int FindBlockCommentEndIn(const std::string& text) {
+  const auto& text16 = base::ASCIIToUTF16(text);
+  const auto offset8 =
+      FindBlockCommentEnd(Begin(text), End(text)) - Begin(text);
+  const auto offset16 =
+      FindBlockCommentEnd(text16.data(), text16.data() + text16.size()) -
+      text16.data();
+  return offset8 == offset16 ? static_cast<int>(offset8) : -1;
+}
+
+int FindCharIn(const std::string& text, char char_code) {
+  const auto& text16 = base::ASCIIToUTF16(text);
+  const auto offset8 =
+      FindChar(Begin(text), End(text), char_code) - Begin(text);
+  const auto offset16 =
+      FindChar(text16.data(), text16.data() + text16.size(), char_code) -
+      text16.data();
+  return offset8 == offset16 ? static_cast<int>(offset8) : -1;
+}
+
+int FindLineTerminatorIn(const std::string& text) {
+  const auto& text16 = base::ASCIIToUTF16(text);
+  const auto offset8 = FindLineTerminator(Begin(text), End(text)) - Begin(text);
+  const auto offset16 =
+      FindLineTerminator(text16.data(), text16.data() + text16.size()) -
+      text16.data();
+  return offset8 == offset16 ? static_cast<int>(offset8) : -1;
+}
+
+int SkipSpacesIn(const std::string& text) {
+  const auto& text16 = base::ASCIIToUTF16(text);
+  const auto offset8 = SkipSpaces(Begin(text), End(text)) - Begin(text);
+  const auto offset16 =
+      SkipSpaces(text16.data(), text16.data() + text16.size()) - text16.data();
+  return offset8 == offset16 ? static_cast<int>(offset8) : -1;
+}
+
+}  // namespace
+
+TEST(CharacterScannerTest, FindBlockCommentEnd) {
+  EXPECT_EQ(0, FindBlockCommentEndIn(""));
+  EXPECT_EQ(1, FindBlockCommentEndIn("*/"));
+  EXPECT_EQ(1, FindBlockCommentEndIn("/")) << "'*' should be in range";
+  EXPECT_EQ(2, FindBlockCommentEndIn("/*/"));
+  EXPECT_EQ(21, FindBlockCommentEndIn(" * foo bar baz quux */ */"));
+  EXPECT_EQ(39, FindBlockCommentEndIn(std::string(39, '*') + "/"));
+  EXPECT_EQ(40, FindBlockCommentEndIn(std::string(40, '*')));
+}
+
+TEST(CharacterScannerTest, FindChar) {
+  EXPECT_EQ(0, FindCharIn("", '@'));
+  EXPECT_EQ(0, FindCharIn("@", '@'));
+  EXPECT_EQ(3, FindCharIn("abc", '@'));
+  EXPECT_EQ(17, FindCharIn(" * 0123456789abc @param", '@'));
+  EXPECT_EQ(33, FindCharIn(std::string(33, 'a') + "@", '@'));
+}
+
+TEST(CharacterScannerTest, FindLineTerminator) {
+  EXPECT_EQ(0, FindLineTerminatorIn(""));
+  EXPECT_EQ(0, FindLineTerminatorIn("\n"));
+  EXPECT_EQ(3, FindLineTerminatorIn("abc\r\n"));
+  EXPECT_EQ(20, FindLineTerminatorIn("// 0123456789abcdefg\n"));
+  EXPECT_EQ(50, FindLineTerminatorIn(std::string(50, 'a')));
+
+  const base::char16 kText[] = {'a', 'b', 0x2029, 'c', 0x2028};
+  EXPECT_EQ(kText + 2, FindLineTerminator(kText, kText + 5));
+  EXPECT_EQ(kText + 4, FindLineTerminator(kText + 3, kText + 5));
+}
+
+TEST(CharacterScannerTest, SkipSpaces) {
+  EXPECT_EQ(0, SkipSpacesIn(""));
+  EXPECT_EQ(0, SkipSpacesIn("a"));
+  EXPECT_EQ(2, SkipSpacesIn(" \tfoo"));
+  EXPECT_EQ(0, SkipSpacesIn("\n  "));
+  EXPECT_EQ(24, SkipSpacesIn(std::string(24, ' ') + "return"));
+  EXPECT_EQ(40, SkipSpacesIn(std::string(40, '\t')));
+}
+
+}  // namespace aoba
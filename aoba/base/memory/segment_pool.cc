@@ -0,0 +1,131 @@
+// Copyright (c) 2016 Project Vogue. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <stdint.h>
+
+#include <new>
+
+#include "aoba/base/memory/segment_pool.h"
+
+#include "base/memory/singleton.h"
+#include "build/build_config.h"
+
+#if defined(OS_POSIX)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace aoba {
+
+namespace {
+
+const size_t kMinBlockSize = 8 * 1024;
+
+// Free list holds at most |kMaxPooledBytesPerSizeClass| bytes of blocks, e.g.
+// 512 blocks of 8KB, or 4 blocks of 1MB.
+const size_t kMaxPooledBytesPerSizeClass = 4 * 1024 * 1024;
+
+#if defined(OS_POSIX)
+void DiscardPages(void* block, size_t size) {
+  static const auto page_size = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+  const auto start = reinterpret_cast<uintptr_t>(block);
+  const auto page_start = (start + page_size - 1) & ~(page_size - 1);
+  const auto page_end = (start + size) & ~(page_size - 1);
+  if (page_start >= page_end)
+    return;
+  ::madvise(reinterpret_cast<void*>(page_start), page_end - page_start,
+            MADV_DONTNEED);
+}
+#endif
+
+}  // namespace
+
+//////////////////////////////////////////////////////////////////////
+//
+// SegmentPool
+//
+SegmentPool::SegmentPool() = default;
+SegmentPool::~SegmentPool() = default;
+
+// static
+SegmentPool* SegmentPool::GetInstance() {
+  // Zones in other singletons may return segments after exit.
+  return base::Singleton<SegmentPool,
+                         base::LeakySingletonTraits<SegmentPool>>::get();
+}
+
+size_t SegmentPool::pooled_bytes() const {
+  base::AutoLock lock(lock_);
+  size_t size = kMinBlockSize;
+  size_t total = 0;
+  for (const auto& free_list : free_lists_) {
+    total += free_list.blocks.size() * size;
+    size *= 2;
+  }
+  return total;
+}
+
+void* SegmentPool::Allocate(size_t size) {
+  if (auto* const free_list = FreeListFor(size)) {
+    base::AutoLock lock(lock_);
+    if (!free_list->blocks.empty()) {
+      auto* const block = free_list->blocks.back();
+      free_list->blocks.pop_back();
+      if (free_list->number_of_trimmed > free_list->blocks.size())
+        free_list->number_of_trimmed = free_list->blocks.size();
+      return block;
+    }
+  }
+  return ::operator new(size);
+}
+
+SegmentPool::FreeList* SegmentPool::FreeListFor(size_t size) {
+  auto block_size = kMinBlockSize;
+  for (auto& free_list : free_lists_) {
+    if (size == block_size)
+      return &free_list;
+    block_size *= 2;
+  }
+  return nullptr;
+}
+
+void SegmentPool::Free(void* block, size_t size) {
+  if (auto* const free_list = FreeListFor(size)) {
+    base::AutoLock lock(lock_);
+    if ((free_list->blocks.size() + 1) * size <= kMaxPooledBytesPerSizeClass) {
+      free_list->blocks.push_back(block);
+      return;
+    }
+  }
+  ::operator delete(block);
+}
+
+void SegmentPool::Release() {
+  base::AutoLock lock(lock_);
+  for (auto& free_list : free_lists_) {
+    for (auto* const block : free_list.blocks)
+      ::operator delete(block);
+    free_list.blocks.clear();
+    free_list.number_of_trimmed = 0;
+  }
+}
+
+void SegmentPool::Trim() {
+#if defined(OS_POSIX)
+  base::AutoLock lock(lock_);
+  size_t size = kMinBlockSize;
+  for (auto& free_list : free_lists_) {
+    for (auto index = free_list.number_of_trimmed;
+         index < free_list.blocks.size(); ++index) {
+      DiscardPages(free_list.blocks[index], size);
+    }
+    free_list.number_of_trimmed = free_list.blocks.size();
+    size *= 2;
+  }
+#else
+  Release();
+#endif
+}
+
+}  // namespace aoba
@@ -0,0 +1,77 @@
+// Copyright (c) 2016 Project Vogue. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef AOBA_BASE_MEMORY_SEGMENT_POOL_H_
+#define AOBA_BASE_MEMORY_SEGMENT_POOL_H_
+
+#include <array>
+#include <vector>
+
+#include "base/macros.h"
+#include "base/synchronization/lock.h"
+#include "aoba/base/base_export.h"
+
+namespace base {
+template <typename T>
+struct DefaultSingletonTraits;
+}
+
+namespace aoba {
+
+//////////////////////////////////////////////////////////////////////
+//
+// SegmentPool
+// Process-wide pool of memory blocks for |Zone| segments. Blocks of power of
+// two size from 8KB to 1MB are kept in bounded free lists by size, and other
+// blocks are allocated from and returned to system directly.
+//
+class AOBA_BASE_EXPORT SegmentPool final {
+ public:
+  static SegmentPool* GetInstance();
+
+  // Returns number of bytes in free lists.
+  size_t pooled_bytes() const;
+
+  // Returns a memory block of |size| bytes.
+  void* Allocate(size_t size);
+
+  // Returns |block| allocated by |Allocate(size)| to the pool.
+  void Free(void* block, size_t size);
+
+  // Releases all blocks in free lists to system.
+  void Release();
+
+  // Returns physical pages of blocks in free lists to system with keeping
+  // blocks in free lists. On platforms without |madvise()|, this function
+  // is same as |Release()|.
+  void Trim();
+
+ private:
+  friend struct base::DefaultSingletonTraits<SegmentPool>;
+
+  // Free list of blocks of same size. Blocks in |blocks[0]| to
+  // |blocks[number_of_trimmed - 1]| don't have physical pages.
+  struct FreeList {
+    std::vector<void*> blocks;
+    size_t number_of_trimmed = 0;
+  };
+
+  static const size_t kNumberOfSizeClasses = 8;
+
+  SegmentPool();
+  ~SegmentPool();
+
+  // Returns free list for blocks of |size| bytes, or null if |size| is not
+  // pooled.
+  FreeList* FreeListFor(size_t size);
+
+  mutable base::Lock lock_;
+  std::array<FreeList, kNumberOfSizeClasses> free_lists_;
+
+  DISALLOW_COPY_AND_ASSIGN(SegmentPool);
+};
+
+}  // namespace aoba
+
+#endif  // AOBA_BASE_MEMORY_SEGMENT_POOL_H_
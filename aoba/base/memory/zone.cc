@@ -2,97 +2,399 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <stdint.h>
+
+#include <algorithm>
+#include <new>
 #include <utility>
 
 #include "aoba/base/memory/zone.h"
 
+#include "base/logging.h"
+#include "build/build_config.h"
+#include "aoba/base/memory/segment_pool.h"
 #include "aoba/base/memory/zone_allocated.h"
+#include "aoba/base/memory/zone_registry.h"
+
+#if defined(OS_LINUX)
+#include <sys/mman.h>
+#endif
 
 namespace aoba {
 
 namespace {
 const size_t kAllocateUnit = 8;
 const size_t kMinSegmentSize = 8 * 1024;
+const size_t kMaxSegmentSize = 1024 * 1024;
+
+// Requests larger than |kLargeObjectSize| bytes are allocated in dedicated
+// segments.
+const size_t kLargeObjectSize = 64 * 1024;
+
+// Segments of |Zone::Backing::HugePages| grow from 2MB to 64MB.
+const size_t kHugePageSize = 2 * 1024 * 1024;
+const size_t kMaxHugePageSegmentSize = 64 * 1024 * 1024;
 
 size_t RoundUp(size_t num, size_t unit) {
   return ((num + unit - 1) / unit) * unit;
 }
 
+// Returns number of bytes to reserve for aligning memory to |alignment|.
+size_t PaddingFor(size_t alignment) {
+  return std::max(alignment, kAllocateUnit) - kAllocateUnit;
+}
+
+size_t InitialSegmentSize(Zone::Backing backing) {
+  return backing == Zone::Backing::HugePages ? kHugePageSize : kMinSegmentSize;
+}
+
+#if defined(OS_LINUX)
+// Returns |size| bytes of memory aligned to |kHugePageSize|. Physical pages
+// are committed on first touch.
+void* AllocateHugePages(size_t size) {
+  DCHECK_EQ(size % kHugePageSize, 0u);
+  const auto reserve_size = size + kHugePageSize;
+  auto* const reserved =
+      ::mmap(nullptr, reserve_size, PROT_READ | PROT_WRITE,
+             MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+  CHECK_NE(MAP_FAILED, reserved) << "Failed to reserve " << reserve_size;
+  const auto start = reinterpret_cast<uintptr_t>(reserved);
+  const auto aligned_start = RoundUp(start, kHugePageSize);
+  if (aligned_start != start)
+    ::munmap(reserved, aligned_start - start);
+  const auto tail_size = start + reserve_size - (aligned_start + size);
+  if (tail_size)
+    ::munmap(reinterpret_cast<void*>(aligned_start + size), tail_size);
+  auto* const pages = reinterpret_cast<void*>(aligned_start);
+  ::madvise(pages, size, MADV_HUGEPAGE);
+  return pages;
+}
+
+void FreeHugePages(void* pages, size_t size) {
+  ::munmap(pages, size);
+}
+#else
+void* AllocateHugePages(size_t size) {
+  return SegmentPool::GetInstance()->Allocate(size);
+}
+
+void FreeHugePages(void* pages, size_t size) {
+  SegmentPool::GetInstance()->Free(pages, size);
+}
+#endif
+
 }  // namespace
 
 //////////////////////////////////////////////////////////////////////
 //
 // Zone::Segment
+// |Segment| is allocated with its memory in one block from |SegmentPool|.
+// Memory starts right after the |Segment| object.
 //
 class Zone::Segment final {
  public:
-  Segment(size_t size, Segment* next);
-  ~Segment();
-
   Segment* next() const { return next_; }
+  void set_next(Segment* next) { next_ = next; }
+
+  size_t offset() const { return offset_; }
+
+  // Returns number of bytes available in this segment.
+  size_t remaining() const { return max_offset_ - offset_; }
+
+  // Returns true if |pointer| is in allocated memory at or after
+  // |start_offset|.
+  bool Contains(const void* pointer, size_t start_offset) const;
+
+  void* Allocate(size_t size, size_t alignment);
+  bool Resize(void* pointer, size_t old_size, size_t new_size);
+  void Rewind(size_t offset);
 
-  void* Allocate(size_t size);
+  // Returns a segment in a block of |block_size| bytes.
+  static Segment* New(size_t block_size, Segment* next);
+  static Segment* NewHugePages(size_t block_size, Segment* next);
+  static void Delete(Segment* segment);
 
  private:
-  Segment* const next_;
+  Segment(size_t size, Segment* next, bool is_huge_pages);
+  ~Segment();
+
+  char* memory() { return reinterpret_cast<char*>(this + 1); }
+  const char* memory() const {
+    return reinterpret_cast<const char*>(this + 1);
+  }
+
+  bool const is_huge_pages_;
+  Segment* next_;
   size_t const max_offset_;
   size_t offset_;
-  char* memory_;
 
   DISALLOW_COPY_AND_ASSIGN(Segment);
 };
 
-Zone::Segment::Segment(size_t size, Segment* next)
-    : next_(next),
-      max_offset_(RoundUp(size, kMinSegmentSize)),
-      offset_(0u),
-      memory_(new char[max_offset_]) {}
+Zone::Segment::Segment(size_t size, Segment* next, bool is_huge_pages)
+    : is_huge_pages_(is_huge_pages),
+      next_(next),
+      max_offset_(size),
+      offset_(0u) {}
 
-Zone::Segment::~Segment() {
-  delete[] memory_;
+Zone::Segment::~Segment() = default;
+
+bool Zone::Segment::Contains(const void* pointer, size_t start_offset) const {
+  const auto* const start = static_cast<const char*>(pointer);
+  return start >= &memory()[start_offset] && start < &memory()[offset_];
 }
 
-void* Zone::Segment::Allocate(size_t size) {
-  const auto allocate_size = RoundUp(size, kAllocateUnit);
-  const auto next_offset = offset_ + allocate_size;
+void* Zone::Segment::Allocate(size_t size, size_t alignment) {
+  DCHECK_EQ(size % kAllocateUnit, 0u);
+  const auto start = reinterpret_cast<uintptr_t>(&memory()[offset_]);
+  const auto padding = ((start + alignment - 1) & ~(alignment - 1)) - start;
+  const auto next_offset = offset_ + padding + size;
   if (next_offset > max_offset_)
     return nullptr;
-  auto* result = &memory_[offset_];
+  auto* result = &memory()[offset_ + padding];
   offset_ = next_offset;
   return result;
 }
 
+bool Zone::Segment::Resize(void* pointer, size_t old_size, size_t new_size) {
+  auto* const start = static_cast<char*>(pointer);
+  if (start + old_size != &memory()[offset_])
+    return false;
+  const auto start_offset = static_cast<size_t>(start - memory());
+  if (start_offset + new_size > max_offset_)
+    return false;
+  offset_ = start_offset + new_size;
+  return true;
+}
+
+void Zone::Segment::Rewind(size_t offset) {
+  DCHECK_LE(offset, offset_);
+  offset_ = offset;
+}
+
+// static
+Zone::Segment* Zone::Segment::New(size_t block_size, Segment* next) {
+  static_assert(sizeof(Segment) % kAllocateUnit == 0,
+                "Segment memory should be aligned to kAllocateUnit");
+  DCHECK_GT(block_size, sizeof(Segment));
+  auto* const block = SegmentPool::GetInstance()->Allocate(block_size);
+  return new (block) Segment(block_size - sizeof(Segment), next, false);
+}
+
+// static
+Zone::Segment* Zone::Segment::NewHugePages(size_t block_size, Segment* next) {
+  auto* const block = AllocateHugePages(block_size);
+  return new (block) Segment(block_size - sizeof(Segment), next, true);
+}
+
+// static
+void Zone::Segment::Delete(Segment* segment) {
+  const auto block_size = sizeof(Segment) + segment->max_offset_;
+  const auto is_huge_pages = segment->is_huge_pages_;
+  segment->~Segment();
+  if (is_huge_pages)
+    return FreeHugePages(segment, block_size);
+  SegmentPool::GetInstance()->Free(segment, block_size);
+}
+
+//////////////////////////////////////////////////////////////////////
+//
+// Zone::Checkpoint
+//
+Zone::Checkpoint::Checkpoint(Segment* segment,
+                             Segment* next,
+                             size_t offset,
+                             size_t next_segment_size,
+                             const ZoneStats& stats)
+    : next_(next),
+      next_segment_size_(next_segment_size),
+      offset_(offset),
+      segment_(segment),
+      stats_(stats) {}
+
+Zone::Checkpoint::Checkpoint(const Checkpoint& other) = default;
+Zone::Checkpoint::~Checkpoint() = default;
+
 //////////////////////////////////////////////////////////////////////
 //
 // Zone
 //
-Zone::Zone(Zone&& other) : name_(other.name_), segment_(other.segment_) {
+Zone::Zone(Zone&& other)
+    : backing_(other.backing_),
+      name_(other.name_),
+      registration_(other.registration_),
+      next_segment_size_(other.next_segment_size_),
+      segment_(other.segment_),
+      stats_(other.stats_) {
+  other.next_segment_size_ = InitialSegmentSize(other.backing_);
   other.segment_ = nullptr;
+  other.stats_ = ZoneStats();
+  if (registration_ == Registration::Registered)
+    ZoneRegistry::GetInstance()->Register(this);
+}
+
+Zone::Zone(const char* name, Backing backing, Registration registration)
+    : backing_(backing),
+      name_(name),
+      registration_(registration),
+      next_segment_size_(InitialSegmentSize(backing)),
+      segment_(nullptr) {
+  if (registration_ == Registration::Registered)
+    ZoneRegistry::GetInstance()->Register(this);
 }
 
-Zone::Zone(const char* name) : name_(name), segment_(new Segment(0, nullptr)) {}
+Zone::Zone(const char* name, Backing backing)
+    : Zone(name, backing, Registration::Registered) {}
+
+Zone::Zone(const char* name) : Zone(name, Backing::Heap) {}
 
 Zone::~Zone() {
-  auto* segment = segment_;
-  while (segment) {
-    auto* const next_segment = segment->next();
-    delete segment;
-    segment = next_segment;
-  }
+  DeleteSegments();
+  if (registration_ == Registration::Registered)
+    ZoneRegistry::GetInstance()->Unregister(this);
 }
 
 Zone& Zone::operator=(Zone&& other) {
+  DeleteSegments();
+  if (registration_ != other.registration_) {
+    if (registration_ == Registration::Registered)
+      ZoneRegistry::GetInstance()->Unregister(this);
+    else
+      ZoneRegistry::GetInstance()->Register(this);
+  }
+  backing_ = other.backing_;
+  name_ = other.name_;
+  registration_ = other.registration_;
+  next_segment_size_ = other.next_segment_size_;
   segment_ = other.segment_;
+  stats_ = other.stats_;
+  other.next_segment_size_ = InitialSegmentSize(other.backing_);
   other.segment_ = nullptr;
+  other.stats_ = ZoneStats();
   return *this;
 }
 
 void* Zone::Allocate(size_t size) {
-  for (;;) {
-    if (auto* pointer = segment_->Allocate(size))
+  return Allocate(size, kAllocateUnit);
+}
+
+void* Zone::Allocate(size_t size, size_t alignment) {
+  DCHECK(alignment && (alignment & (alignment - 1)) == 0) << alignment;
+  stats_.bytes_requested += size;
+  const auto allocate_size = RoundUp(size, kAllocateUnit);
+  if (segment_) {
+    if (auto* pointer = segment_->Allocate(allocate_size, alignment))
       return pointer;
-    segment_ = new Segment(size, segment_);
   }
+  const auto padded_size = allocate_size + PaddingFor(alignment);
+  if (padded_size > kLargeObjectSize)
+    return AllocateLarge(allocate_size, alignment);
+  if (segment_)
+    stats_.tail_waste += segment_->remaining();
+  auto segment_size = next_segment_size_;
+  while (segment_size < sizeof(Segment) + padded_size)
+    segment_size *= 2;
+  if (backing_ == Backing::HugePages) {
+    segment_ = Segment::NewHugePages(segment_size, segment_);
+    next_segment_size_ =
+        std::min(next_segment_size_ * 2, kMaxHugePageSegmentSize);
+  } else {
+    segment_ = Segment::New(segment_size, segment_);
+    next_segment_size_ = std::min(next_segment_size_ * 2, kMaxSegmentSize);
+  }
+  ++stats_.number_of_segments;
+  stats_.bytes_reserved += segment_size;
+  return segment_->Allocate(allocate_size, alignment);
+}
+
+Zone::Checkpoint Zone::CreateCheckpoint() const {
+  if (!segment_)
+    return Checkpoint(nullptr, nullptr, 0, next_segment_size_, stats_);
+  return Checkpoint(segment_, segment_->next(), segment_->offset(),
+                    next_segment_size_, stats_);
+}
+
+// Walks segments as same as |Rewind()|.
+bool Zone::IsAllocatedAfter(const Checkpoint& checkpoint,
+                            const void* pointer) const {
+  auto* segment = segment_;
+  while (segment != checkpoint.segment_) {
+    if (segment->Contains(pointer, 0))
+      return true;
+    segment = segment->next();
+  }
+  if (!segment)
+    return false;
+  for (auto* runner = segment->next(); runner != checkpoint.next_;
+       runner = runner->next()) {
+    if (runner->Contains(pointer, 0))
+      return true;
+  }
+  return segment->Contains(pointer, checkpoint.offset_);
+}
+
+// Dedicated segment is linked after the current segment to keep bump
+// allocation in the current segment.
+void* Zone::AllocateLarge(size_t size, size_t alignment) {
+  const auto block_size = sizeof(Segment) + size + PaddingFor(alignment);
+  DCHECK_GT(block_size, kLargeObjectSize);
+  ++stats_.number_of_segments;
+  stats_.bytes_reserved += block_size;
+  if (!segment_) {
+    segment_ = Segment::New(block_size, nullptr);
+    return segment_->Allocate(size, alignment);
+  }
+  auto* const segment = Segment::New(block_size, segment_->next());
+  segment_->set_next(segment);
+  return segment->Allocate(size, alignment);
+}
+
+bool Zone::Resize(void* pointer, size_t old_size, size_t new_size) {
+  if (!segment_)
+    return false;
+  if (!segment_->Resize(pointer, RoundUp(old_size, kAllocateUnit),
+                        RoundUp(new_size, kAllocateUnit))) {
+    return false;
+  }
+  stats_.bytes_requested = stats_.bytes_requested - old_size + new_size;
+  return true;
+}
+
+void Zone::Rewind(const Checkpoint& checkpoint) {
+  // Release segments created after |checkpoint|.
+  while (segment_ != checkpoint.segment_) {
+    DCHECK(segment_) << "Checkpoint isn't created by " << name_;
+    auto* const next_segment = segment_->next();
+    Segment::Delete(segment_);
+    segment_ = next_segment;
+  }
+  if (segment_) {
+    // Release dedicated segments created after |checkpoint|.
+    while (segment_->next() != checkpoint.next_) {
+      auto* const large_segment = segment_->next();
+      DCHECK(large_segment) << "Checkpoint isn't created by " << name_;
+      segment_->set_next(large_segment->next());
+      Segment::Delete(large_segment);
+    }
+    segment_->Rewind(checkpoint.offset_);
+  }
+  next_segment_size_ = checkpoint.next_segment_size_;
+  stats_ = checkpoint.stats_;
+}
+
+void Zone::DeleteSegments() {
+  if (segment_)
+    stats_.tail_waste += segment_->remaining();
+  if (registration_ == Registration::Registered)
+    ZoneRegistry::GetInstance()->Retire(name_, stats_);
+  stats_ = ZoneStats();
+  auto* segment = segment_;
+  while (segment) {
+    auto* const next_segment = segment->next();
+    Segment::Delete(segment);
+    segment = next_segment;
+  }
+  segment_ = nullptr;
 }
 
 }  // namespace aoba
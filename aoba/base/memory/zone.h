@@ -7,36 +7,137 @@
 
 #include "base/macros.h"
 #include "aoba/base/base_export.h"
+#include "aoba/base/memory/zone_stats.h"
 
 namespace aoba {
 
 //////////////////////////////////////////////////////////////////////
 //
 // Zone
+// |Zone| allocates memory from segments. Segment size grows geometrically
+// from 8KB to 1MB, and large requests are served by dedicated segments so
+// that they don't throw away the rest of the current segment. Released
+// segments are recycled by |SegmentPool|.
 //
 class AOBA_BASE_EXPORT Zone final {
+ private:
+  class Segment;
+
  public:
+  class Checkpoint;
+
+  // Backing memory of segments for small allocations.
+  enum class Backing {
+    // Segments are allocated from |SegmentPool|.
+    Heap,
+    // Segments are reserved by |mmap()| in huge page size alignment with
+    // requesting transparent huge pages, for zones of hundreds of MB, e.g.
+    // AST nodes of large source code, to reduce TLB misses. On platforms
+    // without transparent huge pages, this is same as |Heap|.
+    HugePages,
+  };
+
+  // Whether |ZoneRegistry| reports memory usage of the zone.
+  enum class Registration {
+    Registered,
+    // For short-lived zones, e.g. per thread zones of |ParallelLexer|, to
+    // avoid taking the lock of |ZoneRegistry| on construction and
+    // destruction.
+    Unregistered,
+  };
+
   Zone(const Zone& other) = delete;
   Zone(Zone&& other);
+  Zone(const char* name, Backing backing, Registration registration);
+  Zone(const char* name, Backing backing);
   explicit Zone(const char* name);
   ~Zone();
 
   Zone& operator=(const Zone& other) = delete;
   Zone& operator=(Zone&& other);
 
-  // Allocate |size| bytes of memory in the Zone.
+  const char* name() const { return name_; }
+  const ZoneStats& stats() const { return stats_; }
+
+  // Allocate |size| bytes of memory in the Zone. Memory is aligned to 8
+  // bytes.
   void* Allocate(size_t size);
 
+  // Allocate |size| bytes of memory aligned to |alignment|, which should be
+  // power of two, e.g. 16, 32 or 64 for SIMD friendly tables.
+  void* Allocate(size_t size, size_t alignment);
+
   template <typename T>
   T* AllocateObjects(size_t length) {
-    return static_cast<T*>(Allocate(length * sizeof(T)));
+    return static_cast<T*>(Allocate(length * sizeof(T), alignof(T)));
   }
 
+  // Resizes memory block |pointer| of |old_size| bytes to |new_size| bytes in
+  // place. Returns false if |pointer| isn't the last allocated block or there
+  // is no room in the current segment.
+  bool Resize(void* pointer, size_t old_size, size_t new_size);
+
+  // Returns current allocation state for |Rewind()|.
+  Checkpoint CreateCheckpoint() const;
+
+  // Returns true if |pointer| is allocated after |checkpoint|, i.e. memory of
+  // |pointer| is released by |Rewind(checkpoint)|.
+  bool IsAllocatedAfter(const Checkpoint& checkpoint,
+                        const void* pointer) const;
+
+  // Releases memory allocated after |checkpoint|. Objects allocated after
+  // |checkpoint| must not be used after this call. Checkpoints created after
+  // |checkpoint| are no longer valid.
+  void Rewind(const Checkpoint& checkpoint);
+
  private:
-  class Segment;
+  // Allocates |size| bytes of memory aligned to |alignment| in a dedicated
+  // segment.
+  void* AllocateLarge(size_t size, size_t alignment);
+
+  // Releases all segments and reports |stats_| to |ZoneRegistry| if the zone
+  // is registered.
+  void DeleteSegments();
+
+  Backing backing_;
+  const char* name_;
+  Registration registration_;
+
+  // Size of the next segment for small allocations.
+  size_t next_segment_size_;
+
+  // The current segment for bump allocation. Segments are chained via
+  // |Segment::next()|.
+  Segment* segment_;
+
+  ZoneStats stats_;
+};
+
+//////////////////////////////////////////////////////////////////////
+//
+// Zone::Checkpoint
+//
+class AOBA_BASE_EXPORT Zone::Checkpoint final {
+ public:
+  Checkpoint(const Checkpoint& other);
+  ~Checkpoint();
+
+ private:
+  friend class Zone;
+
+  Checkpoint(Segment* segment,
+             Segment* next,
+             size_t offset,
+             size_t next_segment_size,
+             const ZoneStats& stats);
 
-  const char* const name_;
+  // |segment_->next()| at checkpoint. Dedicated segments for large objects
+  // allocated after checkpoint are linked before |next_|.
+  Segment* next_;
+  size_t next_segment_size_;
+  size_t offset_;
   Segment* segment_;
+  ZoneStats stats_;
 };
 
 }  // namespace aoba
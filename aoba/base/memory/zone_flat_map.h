@@ -0,0 +1,226 @@
+// Copyright (c) 2016 Project Vogue. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef AOBA_BASE_MEMORY_ZONE_FLAT_MAP_H_
+#define AOBA_BASE_MEMORY_ZONE_FLAT_MAP_H_
+
+#include <stdint.h>
+
+#include <functional>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "base/logging.h"
+#include "base/macros.h"
+#include "aoba/base/memory/zone.h"
+
+namespace aoba {
+
+//////////////////////////////////////////////////////////////////////
+//
+// ZoneFlatMap
+// An open addressing hash map in |Zone|. Up to |kInlineCapacity| entries are
+// stored in the map itself and looked up by linear search. Larger maps use a
+// linear probing table allocated in |Zone|. Entries can not be removed, and
+// iterators are invalidated by insertion.
+//
+template <typename K,
+          typename T,
+          typename Hash = std::hash<K>,
+          typename KeyEqual = std::equal_to<K>,
+          size_t kInlineCapacity = 4>
+class ZoneFlatMap final {
+ public:
+  using key_type = K;
+  using mapped_type = T;
+  using value_type = std::pair<K, T>;
+
+  static_assert(std::is_trivially_destructible<value_type>::value,
+                "Zone doesn't call destructor");
+
+ private:
+  struct Slot {
+    bool used;
+    typename std::aligned_storage<sizeof(value_type),
+                                  alignof(value_type)>::type storage;
+
+    value_type& entry() { return *reinterpret_cast<value_type*>(&storage); }
+    const value_type& entry() const {
+      return *reinterpret_cast<const value_type*>(&storage);
+    }
+  };
+
+ public:
+  template <typename Value, typename SlotType>
+  class Iterator final
+      : public std::iterator<std::forward_iterator_tag, Value> {
+   public:
+    Iterator(SlotType* slot, SlotType* end) : end_(end), slot_(slot) {
+      SkipUnused();
+    }
+
+    template <typename OtherValue, typename OtherSlotType>
+    Iterator(const Iterator<OtherValue, OtherSlotType>& other)
+        : end_(other.end_), slot_(other.slot_) {}
+
+    Value& operator*() const { return slot_->entry(); }
+    Value* operator->() const { return &slot_->entry(); }
+
+    Iterator& operator++() {
+      ++slot_;
+      SkipUnused();
+      return *this;
+    }
+
+    bool operator==(const Iterator& other) const {
+      return slot_ == other.slot_;
+    }
+
+    bool operator!=(const Iterator& other) const {
+      return slot_ != other.slot_;
+    }
+
+   private:
+    template <typename OtherValue, typename OtherSlotType>
+    friend class Iterator;
+
+    void SkipUnused() {
+      while (slot_ != end_ && !slot_->used)
+        ++slot_;
+    }
+
+    SlotType* end_;
+    SlotType* slot_;
+  };
+
+  using iterator = Iterator<value_type, Slot>;
+  using const_iterator = Iterator<const value_type, const Slot>;
+
+  explicit ZoneFlatMap(Zone* zone)
+      : capacity_(kInlineCapacity), slots_(inline_slots_), zone_(*zone) {
+    for (auto& slot : inline_slots_)
+      slot.used = false;
+  }
+
+  ~ZoneFlatMap() = default;
+
+  iterator begin() { return iterator(slots_, slots_ + capacity_); }
+  const_iterator begin() const {
+    return const_iterator(slots_, slots_ + capacity_);
+  }
+  iterator end() { return iterator(slots_ + capacity_, slots_ + capacity_); }
+  const_iterator end() const {
+    return const_iterator(slots_ + capacity_, slots_ + capacity_);
+  }
+
+  bool empty() const { return size_ == 0; }
+  size_t size() const { return size_; }
+
+  size_t count(const K& key) const { return find(key) == end() ? 0 : 1; }
+
+  std::pair<iterator, bool> emplace(const K& key, const T& value) {
+    if (auto* slot = FindSlot(key))
+      return std::make_pair(iterator(slot, slots_ + capacity_), false);
+    if (is_inline() ? size_ == kInlineCapacity
+                    : (size_ + 1) * 4 > capacity_ * 3) {
+      Grow();
+    }
+    auto* const slot = FreeSlotFor(key);
+    new (&slot->storage) value_type(key, value);
+    slot->used = true;
+    ++size_;
+    return std::make_pair(iterator(slot, slots_ + capacity_), true);
+  }
+
+  iterator find(const K& key) {
+    auto* const slot = FindSlot(key);
+    return slot ? iterator(slot, slots_ + capacity_) : end();
+  }
+
+  const_iterator find(const K& key) const {
+    auto* const slot = const_cast<ZoneFlatMap*>(this)->FindSlot(key);
+    return slot ? const_iterator(slot, slots_ + capacity_) : end();
+  }
+
+ private:
+  static const size_t kMinTableCapacity = 16;
+
+  bool is_inline() const { return slots_ == inline_slots_; }
+
+  // Returns slot index of |key| in hash table. We use Fibonacci hashing to
+  // spread keys of poor hash function, e.g. |std::hash| of pointers.
+  size_t IndexOf(const K& key) const {
+    const auto hash = static_cast<uint64_t>(Hash()(key));
+    return static_cast<size_t>((hash * 0x9E3779B97F4A7C15ull) >> shift_);
+  }
+
+  Slot* FindSlot(const K& key) {
+    if (is_inline()) {
+      for (auto* slot = slots_; slot != slots_ + size_; ++slot) {
+        if (KeyEqual()(slot->entry().first, key))
+          return slot;
+      }
+      return nullptr;
+    }
+    const auto mask = capacity_ - 1;
+    for (auto index = IndexOf(key);; index = (index + 1) & mask) {
+      auto* const slot = &slots_[index];
+      if (!slot->used)
+        return nullptr;
+      if (KeyEqual()(slot->entry().first, key))
+        return slot;
+    }
+  }
+
+  // Returns an unused slot for |key|, which is not in this map.
+  Slot* FreeSlotFor(const K& key) {
+    if (is_inline()) {
+      DCHECK_LT(size_, kInlineCapacity);
+      return &slots_[size_];
+    }
+    const auto mask = capacity_ - 1;
+    auto index = IndexOf(key);
+    while (slots_[index].used)
+      index = (index + 1) & mask;
+    return &slots_[index];
+  }
+
+  void Grow() {
+    const auto new_capacity = is_inline() ? kMinTableCapacity : capacity_ * 2;
+    auto* const old_slots = slots_;
+    const auto old_capacity = is_inline() ? size_ : capacity_;
+    slots_ = zone_.AllocateObjects<Slot>(new_capacity);
+    for (auto* slot = slots_; slot != slots_ + new_capacity; ++slot)
+      slot->used = false;
+    capacity_ = new_capacity;
+    shift_ = 64;
+    for (auto size = capacity_; size > 1; size /= 2)
+      --shift_;
+    for (auto* slot = old_slots; slot != old_slots + old_capacity; ++slot) {
+      if (!slot->used)
+        continue;
+      auto* const new_slot = FreeSlotFor(slot->entry().first);
+      new (&new_slot->storage) value_type(slot->entry());
+      new_slot->used = true;
+    }
+  }
+
+  // Number of slots in |slots_|, power of two in hash table.
+  size_t capacity_;
+  Slot inline_slots_[kInlineCapacity];
+  // |64 - log2(capacity_)| for |IndexOf()|.
+  int shift_ = 64;
+  size_t size_ = 0;
+  // Points |inline_slots_| or hash table in |zone_|.
+  Slot* slots_;
+  Zone& zone_;
+
+  DISALLOW_COPY_AND_ASSIGN(ZoneFlatMap);
+};
+
+}  // namespace aoba
+
+#endif  // AOBA_BASE_MEMORY_ZONE_FLAT_MAP_H_
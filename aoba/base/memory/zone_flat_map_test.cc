@@ -0,0 +1,42 @@
+// Copyright (c) 2016 Project Vogue. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <set>
+
+#include "aoba/base/memory/zone_flat_map.h"
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace aoba {
+
+TEST(ZoneFlatMapTest, Basic) {
+  Zone zone("ZoneFlatMapTest");
+  ZoneFlatMap<int, int> map(&zone);
+  EXPECT_TRUE(map.empty());
+  EXPECT_TRUE(map.emplace(1, 10).second);
+  EXPECT_FALSE(map.emplace(1, 20).second);
+  EXPECT_EQ(1u, map.size());
+  EXPECT_EQ(10, map.find(1)->second);
+  EXPECT_TRUE(map.find(2) == map.end());
+}
+
+TEST(ZoneFlatMapTest, Grow) {
+  Zone zone("ZoneFlatMapTest");
+  ZoneFlatMap<const int*, int> map(&zone);
+  int keys[1000];
+  for (auto index = 0; index < 1000; ++index)
+    EXPECT_TRUE(map.emplace(&keys[index], index).second);
+  EXPECT_EQ(1000u, map.size());
+  for (auto index = 0; index < 1000; ++index) {
+    const auto& it = map.find(&keys[index]);
+    ASSERT_TRUE(it != map.end());
+    EXPECT_EQ(index, it->second);
+  }
+  std::set<int> values;
+  for (const auto& entry : map)
+    values.insert(entry.second);
+  EXPECT_EQ(1000u, values.size());
+}
+
+}  // namespace aoba
@@ -0,0 +1,66 @@
+// Copyright (c) 2016 Project Vogue. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <algorithm>
+
+#include "aoba/base/memory/zone_registry.h"
+
+#include "base/logging.h"
+#include "base/memory/singleton.h"
+#include "aoba/base/memory/zone.h"
+
+namespace aoba {
+
+//////////////////////////////////////////////////////////////////////
+//
+// ZoneRegistry
+//
+ZoneRegistry::ZoneRegistry() = default;
+ZoneRegistry::~ZoneRegistry() = default;
+
+// static
+ZoneRegistry* ZoneRegistry::GetInstance() {
+  // Zones in other singletons may outlive |ZoneRegistry| if we destroy it at
+  // exit.
+  return base::Singleton<ZoneRegistry,
+                         base::LeakySingletonTraits<ZoneRegistry>>::get();
+}
+
+void ZoneRegistry::Register(const Zone* zone) {
+  base::AutoLock lock(lock_);
+  const auto& result = zones_.insert(zone);
+  DCHECK(result.second) << zone->name();
+}
+
+void ZoneRegistry::Retire(const char* name, const ZoneStats& stats) {
+  base::AutoLock lock(lock_);
+  retired_map_[name] += stats;
+}
+
+std::vector<ZoneRegistry::Entry> ZoneRegistry::Snapshot() const {
+  std::map<std::string, ZoneStats> stats_map;
+  {
+    base::AutoLock lock(lock_);
+    stats_map = retired_map_;
+    for (const auto* zone : zones_)
+      stats_map[zone->name()] += zone->stats();
+  }
+  std::vector<Entry> entries(stats_map.begin(), stats_map.end());
+  std::stable_sort(entries.begin(), entries.end(),
+                   [](const Entry& entry1, const Entry& entry2) {
+                     return entry1.second.bytes_reserved >
+                            entry2.second.bytes_reserved;
+                   });
+  return entries;
+}
+
+// Note: |Zone| retires its statistics before calling |Unregister()|.
+void ZoneRegistry::Unregister(const Zone* zone) {
+  base::AutoLock lock(lock_);
+  const auto& it = zones_.find(zone);
+  DCHECK(it != zones_.end()) << zone->name();
+  zones_.erase(it);
+}
+
+}  // namespace aoba
@@ -0,0 +1,70 @@
+// Copyright (c) 2016 Project Vogue. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef AOBA_BASE_MEMORY_ZONE_REGISTRY_H_
+#define AOBA_BASE_MEMORY_ZONE_REGISTRY_H_
+
+#include <map>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "base/macros.h"
+#include "base/synchronization/lock.h"
+#include "aoba/base/base_export.h"
+#include "aoba/base/memory/zone_stats.h"
+
+namespace base {
+template <typename T>
+struct DefaultSingletonTraits;
+}
+
+namespace aoba {
+
+class Zone;
+
+//////////////////////////////////////////////////////////////////////
+//
+// ZoneRegistry
+// Process-wide registry of |Zone| for reporting memory usage.
+//
+class AOBA_BASE_EXPORT ZoneRegistry final {
+ public:
+  using Entry = std::pair<std::string, ZoneStats>;
+
+  static ZoneRegistry* GetInstance();
+
+  // Returns memory usage of zones grouped by zone name, including zones
+  // already destroyed, in descending order of reserved bytes. Since |Zone| is
+  // not thread safe, callers should not allocate in zones during this call.
+  std::vector<Entry> Snapshot() const;
+
+ private:
+  friend class Zone;
+  friend struct base::DefaultSingletonTraits<ZoneRegistry>;
+
+  ZoneRegistry();
+  ~ZoneRegistry();
+
+  void Register(const Zone* zone);
+
+  // Accumulates |stats| of a zone named |name| which releases its segments.
+  void Retire(const char* name, const ZoneStats& stats);
+
+  void Unregister(const Zone* zone);
+
+  mutable base::Lock lock_;
+
+  // Accumulated statistics of destroyed zones.
+  std::map<std::string, ZoneStats> retired_map_;
+
+  std::unordered_set<const Zone*> zones_;
+
+  DISALLOW_COPY_AND_ASSIGN(ZoneRegistry);
+};
+
+}  // namespace aoba
+
+#endif  // AOBA_BASE_MEMORY_ZONE_REGISTRY_H_
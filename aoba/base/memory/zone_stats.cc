@@ -0,0 +1,17 @@
+// Copyright (c) 2016 Project Vogue. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "aoba/base/memory/zone_stats.h"
+
+namespace aoba {
+
+ZoneStats& ZoneStats::operator+=(const ZoneStats& other) {
+  bytes_requested += other.bytes_requested;
+  bytes_reserved += other.bytes_reserved;
+  number_of_segments += other.number_of_segments;
+  tail_waste += other.tail_waste;
+  return *this;
+}
+
+}  // namespace aoba
@@ -0,0 +1,37 @@
+// Copyright (c) 2016 Project Vogue. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef AOBA_BASE_MEMORY_ZONE_STATS_H_
+#define AOBA_BASE_MEMORY_ZONE_STATS_H_
+
+#include <stddef.h>
+
+#include "aoba/base/base_export.h"
+
+namespace aoba {
+
+//////////////////////////////////////////////////////////////////////
+//
+// ZoneStats
+// Memory usage of a |Zone|.
+//
+struct AOBA_BASE_EXPORT ZoneStats final {
+  ZoneStats& operator+=(const ZoneStats& other);
+
+  // Number of bytes passed to |Zone::Allocate()|.
+  size_t bytes_requested = 0;
+
+  // Number of bytes of segments allocated by |Zone|.
+  size_t bytes_reserved = 0;
+
+  size_t number_of_segments = 0;
+
+  // Number of bytes left unused at the end of segments which |Zone| no longer
+  // allocates from.
+  size_t tail_waste = 0;
+};
+
+}  // namespace aoba
+
+#endif  // AOBA_BASE_MEMORY_ZONE_STATS_H_
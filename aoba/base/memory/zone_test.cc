@@ -0,0 +1,194 @@
+// Copyright (c) 2016 Project Vogue. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <stdint.h>
+
+#include <utility>
+
+#include "aoba/base/memory/zone.h"
+#include "aoba/base/memory/segment_pool.h"
+#include "aoba/base/memory/zone_registry.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace aoba {
+
+TEST(ZoneTest, Allocate) {
+  Zone zone("ZoneTest");
+  auto* const pointer1 = static_cast<char*>(zone.Allocate(1));
+  auto* const pointer2 = static_cast<char*>(zone.Allocate(8));
+  auto* const pointer3 = static_cast<char*>(zone.Allocate(9));
+  auto* const pointer4 = static_cast<char*>(zone.Allocate(1));
+  EXPECT_EQ(pointer1 + 8, pointer2);
+  EXPECT_EQ(pointer2 + 8, pointer3);
+  EXPECT_EQ(pointer3 + 16, pointer4);
+}
+
+TEST(ZoneTest, AllocateLarge) {
+  Zone zone("ZoneTest");
+  auto* const pointer1 = static_cast<char*>(zone.Allocate(8));
+  auto* const large = static_cast<char*>(zone.Allocate(1024 * 1024));
+  auto* const pointer2 = static_cast<char*>(zone.Allocate(8));
+  EXPECT_NE(pointer1 + 8, large);
+  EXPECT_EQ(pointer1 + 8, pointer2)
+      << "Large object should not consume the current segment.";
+}
+
+TEST(ZoneTest, AllocateMedium) {
+  Zone zone("ZoneTest");
+  auto* const pointer = static_cast<char*>(zone.Allocate(16 * 1024));
+  ASSERT_NE(nullptr, pointer);
+  pointer[16 * 1024 - 1] = 1;
+  EXPECT_NE(nullptr, zone.Allocate(8));
+}
+
+TEST(ZoneTest, AllocateAligned) {
+  Zone zone("ZoneTest");
+  zone.Allocate(1);
+  auto* const pointer1 = zone.Allocate(16, 64);
+  EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(pointer1) % 64);
+  auto* const pointer2 = zone.Allocate(100 * 1024, 32);
+  EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(pointer2) % 32);
+
+  struct alignas(16) Aligned16 {
+    char data[3];
+  };
+  auto* const objects = zone.AllocateObjects<Aligned16>(3);
+  EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(objects) % 16);
+}
+
+TEST(ZoneTest, AllocateHugePages) {
+  Zone zone("ZoneTest", Zone::Backing::HugePages);
+  auto* const pointer1 = static_cast<char*>(zone.Allocate(8));
+  auto* const pointer2 = static_cast<char*>(zone.Allocate(8));
+  EXPECT_EQ(pointer1 + 8, pointer2);
+  for (auto count = 0; count < 100000; ++count)
+    static_cast<int*>(zone.Allocate(sizeof(int) * 10))[9] = count;
+  EXPECT_EQ(2u, zone.stats().number_of_segments);
+}
+
+TEST(ZoneTest, AllocateMany) {
+  Zone zone("ZoneTest");
+  for (auto count = 0; count < 100000; ++count) {
+    auto* const pointer = static_cast<int*>(zone.Allocate(sizeof(int) * 10));
+    pointer[9] = count;
+  }
+  Zone zone2(std::move(zone));
+  EXPECT_NE(nullptr, zone2.Allocate(100));
+}
+
+TEST(ZoneTest, Resize) {
+  Zone zone("ZoneTest");
+  auto* const pointer1 = static_cast<char*>(zone.Allocate(8));
+  auto* const pointer2 = static_cast<char*>(zone.Allocate(16));
+  EXPECT_FALSE(zone.Resize(pointer1, 8, 16));
+  EXPECT_TRUE(zone.Resize(pointer2, 16, 32));
+  EXPECT_EQ(pointer2 + 32, zone.Allocate(8));
+  EXPECT_FALSE(zone.Resize(pointer2, 32, 1024 * 1024));
+}
+
+TEST(ZoneTest, IsAllocatedAfter) {
+  Zone zone("ZoneTest");
+  auto* const pointer1 = zone.Allocate(8);
+  const auto& checkpoint = zone.CreateCheckpoint();
+  auto* const pointer2 = zone.Allocate(8);
+  auto* const pointer3 = zone.Allocate(1024 * 1024);
+  for (auto count = 0; count < 1000; ++count)
+    zone.Allocate(64);
+  auto* const pointer4 = zone.Allocate(8);
+  EXPECT_FALSE(zone.IsAllocatedAfter(checkpoint, pointer1));
+  EXPECT_TRUE(zone.IsAllocatedAfter(checkpoint, pointer2));
+  EXPECT_TRUE(zone.IsAllocatedAfter(checkpoint, pointer3));
+  EXPECT_TRUE(zone.IsAllocatedAfter(checkpoint, pointer4));
+  EXPECT_FALSE(zone.IsAllocatedAfter(checkpoint, &checkpoint));
+}
+
+TEST(ZoneTest, Rewind) {
+  Zone zone("ZoneTest");
+  zone.Allocate(8);
+  const auto& checkpoint = zone.CreateCheckpoint();
+  auto* const pointer1 = zone.Allocate(8);
+  for (auto count = 0; count < 10000; ++count)
+    zone.Allocate(64);
+  zone.Allocate(1024 * 1024);
+  zone.Rewind(checkpoint);
+  EXPECT_EQ(1u, zone.stats().number_of_segments);
+  EXPECT_EQ(8u, zone.stats().bytes_requested);
+  EXPECT_EQ(pointer1, zone.Allocate(8));
+}
+
+TEST(ZoneTest, RewindLarge) {
+  Zone zone("ZoneTest");
+  const auto& checkpoint1 = zone.CreateCheckpoint();
+  zone.Allocate(1024 * 1024);
+  const auto& checkpoint2 = zone.CreateCheckpoint();
+  zone.Allocate(8);
+  zone.Allocate(1024 * 1024);
+  zone.Rewind(checkpoint2);
+  EXPECT_EQ(1u, zone.stats().number_of_segments);
+  zone.Rewind(checkpoint1);
+  EXPECT_EQ(0u, zone.stats().number_of_segments);
+}
+
+TEST(ZoneTest, SegmentPool) {
+  auto* const pool = SegmentPool::GetInstance();
+  pool->Release();
+  void* pointer1 = nullptr;
+  {
+    Zone zone("ZoneTest");
+    pointer1 = zone.Allocate(8);
+  }
+  EXPECT_NE(0u, pool->pooled_bytes());
+  pool->Trim();
+  Zone zone("ZoneTest");
+  EXPECT_EQ(pointer1, zone.Allocate(8));
+  pool->Release();
+  EXPECT_EQ(0u, pool->pooled_bytes());
+}
+
+TEST(ZoneTest, Stats) {
+  Zone zone("ZoneTest");
+  EXPECT_EQ(0u, zone.stats().number_of_segments);
+  zone.Allocate(3);
+  zone.Allocate(5);
+  EXPECT_EQ(8u, zone.stats().bytes_requested);
+  EXPECT_EQ(1u, zone.stats().number_of_segments);
+  zone.Allocate(1024 * 1024);
+  EXPECT_EQ(2u, zone.stats().number_of_segments);
+  EXPECT_EQ(0u, zone.stats().tail_waste);
+}
+
+TEST(ZoneTest, MoveAssign) {
+  Zone zone("ZoneTest.MoveAssign");
+  zone.Allocate(10);
+  Zone zone2("ZoneTest");
+  zone2 = std::move(zone);
+  EXPECT_STREQ("ZoneTest.MoveAssign", zone2.name());
+  EXPECT_EQ(10u, zone2.stats().bytes_requested);
+}
+
+TEST(ZoneTest, Registry) {
+  {
+    Zone zone("ZoneTest.Registry");
+    zone.Allocate(10);
+  }
+  for (const auto& entry : ZoneRegistry::GetInstance()->Snapshot()) {
+    if (entry.first != "ZoneTest.Registry")
+      continue;
+    EXPECT_LE(10u, entry.second.bytes_requested);
+    return;
+  }
+  ADD_FAILURE() << "Destroyed zone should be in ZoneRegistry.";
+}
+
+TEST(ZoneTest, Unregistered) {
+  {
+    Zone zone("ZoneTest.Unregistered", Zone::Backing::Heap,
+              Zone::Registration::Unregistered);
+    zone.Allocate(10);
+  }
+  for (const auto& entry : ZoneRegistry::GetInstance()->Snapshot())
+    EXPECT_NE("ZoneTest.Unregistered", entry.first);
+}
+
+}  // namespace aoba
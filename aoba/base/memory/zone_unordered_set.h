@@ -23,6 +23,8 @@ template <typename T,
           typename KeyEqual = std::equal_to<T>>
 class ZoneUnorderedSet
     : public std::unordered_set<T, Hash, KeyEqual, ZoneAllocator<T>> {
+  using BaseClass = std::unordered_set<T, Hash, KeyEqual, ZoneAllocator<T>>;
+
  public:
   explicit ZoneUnorderedSet(Zone* zone) : BaseClass(ZoneAllocator<T>(zone)) {}
 
@@ -2,17 +2,52 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <algorithm>
+
 #include "aoba/base/source_code.h"
 
+#include "aoba/base/memory/zone.h"
+#include "aoba/base/source_code_line.h"
 #include "aoba/base/source_code_range.h"
+#include "aoba/base/source_location.h"
 
 namespace aoba {
 
-SourceCode::SourceCode(const base::FilePath& file_path,
-                       base::StringPiece16 file_contents)
-    : file_contents_(file_contents), file_path_(file_path) {}
+namespace {
+
+int* CopyLineStarts(Zone* zone, const std::vector<int>& line_starts) {
+  auto* const data = zone->AllocateObjects<int>(line_starts.size());
+  std::copy(line_starts.begin(), line_starts.end(), data);
+  return data;
+}
+
+}  // namespace
+
+SourceCode::SourceCode(Zone* zone,
+                       const base::FilePath& file_path,
+                       base::StringPiece file_contents,
+                       const std::vector<int>& line_starts)
+    : base_offset_(SourceLocation::Register(this, file_contents.size())),
+      file_path_(file_path),
+      is_one_byte_(true),
+      line_starts_(CopyLineStarts(zone, line_starts)),
+      number_of_line_starts_(static_cast<int>(line_starts.size())),
+      one_byte_contents_(file_contents) {}
+
+SourceCode::SourceCode(Zone* zone,
+                       const base::FilePath& file_path,
+                       base::StringPiece16 file_contents,
+                       const std::vector<int>& line_starts)
+    : base_offset_(SourceLocation::Register(this, file_contents.size())),
+      file_path_(file_path),
+      is_one_byte_(false),
+      line_starts_(CopyLineStarts(zone, line_starts)),
+      number_of_line_starts_(static_cast<int>(line_starts.size())),
+      two_byte_contents_(file_contents) {}
 
-SourceCode::~SourceCode() = default;
+SourceCode::~SourceCode() {
+  SourceLocation::Unregister(base_offset_);
+}
 
 bool SourceCode::operator==(const SourceCode& other) const {
   return this == &other;
@@ -26,29 +61,79 @@ SourceCodeRange SourceCode::end() const {
   return SourceCodeRange(*this, size(), size());
 }
 
+base::StringPiece SourceCode::one_byte_contents() const {
+  DCHECK(is_one_byte());
+  return one_byte_contents_;
+}
+
 SourceCodeRange SourceCode::range() const {
   return SourceCodeRange(*this, 0, size());
 }
 
 int SourceCode::size() const {
-  return static_cast<int>(file_contents_.size());
+  return static_cast<int>(is_one_byte() ? one_byte_contents_.size()
+                                        : two_byte_contents_.size());
 }
 
 SourceCodeRange SourceCode::start() const {
   return SourceCodeRange(*this, 0, 0);
 }
 
+base::StringPiece16 SourceCode::two_byte_contents() const {
+  DCHECK(!is_one_byte());
+  return two_byte_contents_;
+}
+
 base::char16 SourceCode::CharAt(int offset) const {
   DCHECK_GE(offset, 0);
-  DCHECK_LT(static_cast<size_t>(offset), file_contents_.size());
-  return file_contents_[offset];
+  DCHECK_LT(offset, size());
+  if (is_one_byte())
+    return static_cast<base::char16>(one_byte_contents_[offset]);
+  return two_byte_contents_[offset];
+}
+
+std::pair<int, int> SourceCode::LineAndColumnAt(int offset) const {
+  const auto index = LineIndexAt(offset);
+  const auto line_start = index == 0 ? 0 : line_starts_[index - 1];
+  return std::make_pair(index + 1, offset - line_start);
+}
+
+SourceCodeLine SourceCode::LineAt(int offset) const {
+  const auto index = LineIndexAt(offset);
+  const auto line_start = index == 0 ? 0 : line_starts_[index - 1];
+  const auto line_end =
+      index == number_of_line_starts_ ? size() : line_starts_[index];
+  return SourceCodeLine(Slice(line_start, line_end), index + 1);
+}
+
+int SourceCode::LineIndexAt(int offset) const {
+  DCHECK_GE(offset, 0);
+  DCHECK_LE(offset, size());
+  return static_cast<int>(
+      std::upper_bound(line_starts_, line_starts_ + number_of_line_starts_,
+                       offset) -
+      line_starts_);
 }
 
-base::StringPiece16 SourceCode::GetString(int start, int end) const {
+base::StringPiece SourceCode::GetOneByteString(int start, int end) const {
+  DCHECK(is_one_byte());
   DCHECK_GE(start, 0);
   DCHECK_LE(start, end);
-  DCHECK_LE(static_cast<size_t>(end), file_contents_.size());
-  return file_contents_.substr(start, end - start);
+  DCHECK_LE(end, size());
+  return one_byte_contents_.substr(start, end - start);
+}
+
+base::StringPiece16 SourceCode::GetString(int start,
+                                          int end,
+                                          base::string16* buffer) const {
+  DCHECK_GE(start, 0);
+  DCHECK_LE(start, end);
+  DCHECK_LE(end, size());
+  if (!is_one_byte())
+    return two_byte_contents_.substr(start, end - start);
+  const auto& string8 = one_byte_contents_.substr(start, end - start);
+  buffer->assign(string8.begin(), string8.end());
+  return base::StringPiece16(*buffer);
 }
 
 SourceCodeRange SourceCode::Slice(int start, int end) const {
@@ -5,6 +5,11 @@
 #ifndef AOBA_BASE_SOURCE_CODE_H_
 #define AOBA_BASE_SOURCE_CODE_H_
 
+#include <stdint.h>
+
+#include <utility>
+#include <vector>
+
 #include "base/files/file_path.h"
 #include "base/macros.h"
 #include "base/strings/string16.h"
@@ -14,8 +19,14 @@
 
 namespace aoba {
 
+class SourceCodeLine;
 class SourceCodeRange;
+class Zone;
 
+// |SourceCode| holds contents either in one byte characters for ASCII only
+// source code, or in UTF-16. Offsets are UTF-16 code unit offsets in both
+// representations. Start offsets of lines are recorded by |Factory| while
+// copying or decoding contents.
 class AOBA_BASE_EXPORT SourceCode final : public ZoneAllocated {
  public:
   class Factory;
@@ -25,23 +36,58 @@ class AOBA_BASE_EXPORT SourceCode final : public ZoneAllocated {
   bool operator==(const SourceCode& other) const;
   bool operator!=(const SourceCode& other) const;
 
+  // Returns start of offsets of this source code in |SourceLocation| space.
+  uint32_t base_offset() const { return base_offset_; }
   SourceCodeRange end() const;
   const base::FilePath& file_path() const { return file_path_; }
-  const base::StringPiece16 contents() const { return file_contents_; }
+  bool is_one_byte() const { return is_one_byte_; }
+  int number_of_lines() const { return number_of_line_starts_ + 1; }
+  base::StringPiece one_byte_contents() const;
   SourceCodeRange range() const;
   int size() const;
   SourceCodeRange start() const;
+  base::StringPiece16 two_byte_contents() const;
 
   base::char16 CharAt(int offset) const;
-  base::StringPiece16 GetString(int start, int end) const;
+
+  // Returns one origin line number and zero origin column number of
+  // |offset|.
+  std::pair<int, int> LineAndColumnAt(int offset) const;
+
+  // Returns line containing |offset|. A line contains its line terminator.
+  SourceCodeLine LineAt(int offset) const;
+
+  // Returns ASCII string in |[start, end)| of one byte source code.
+  base::StringPiece GetOneByteString(int start, int end) const;
+
+  // Returns string in |[start, end)|. For one byte source code, returned
+  // string is widened into |buffer|, and valid until |buffer| is changed.
+  base::StringPiece16 GetString(int start,
+                                int end,
+                                base::string16* buffer) const;
   SourceCodeRange Slice(int start, int end) const;
 
  private:
-  SourceCode(const base::FilePath& file_path,
-             base::StringPiece16 file_contents);
+  SourceCode(Zone* zone,
+             const base::FilePath& file_path,
+             base::StringPiece file_contents,
+             const std::vector<int>& line_starts);
+  SourceCode(Zone* zone,
+             const base::FilePath& file_path,
+             base::StringPiece16 file_contents,
+             const std::vector<int>& line_starts);
+
+  // Returns zero origin index of line containing |offset|.
+  int LineIndexAt(int offset) const;
 
-  const base::StringPiece16 file_contents_;
+  const uint32_t base_offset_;
   const base::FilePath file_path_;
+  const bool is_one_byte_;
+  // Start offsets of second and later lines, in ascending order.
+  const int* const line_starts_;
+  const int number_of_line_starts_;
+  const base::StringPiece one_byte_contents_;
+  const base::StringPiece16 two_byte_contents_;
 
   DISALLOW_COPY_AND_ASSIGN(SourceCode);
 };
@@ -2,16 +2,126 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <stdint.h>
+
 #include <cstring>
+#include <string>
+#include <vector>
 
 #include "aoba/base/source_code_factory.h"
 
+#include "base/files/file_util.h"
+#include "base/files/memory_mapped_file.h"
+#include "aoba/base/character_scanner.h"
 #include "aoba/base/memory/zone.h"
 
 namespace aoba {
 
+namespace {
+
+const base::char16 kReplacementCharacter = 0xFFFD;
+
+// Records start offsets of lines in |[start, end)| into |line_starts|.
+template <typename T>
+void RecordLineStarts(const T* start,
+                      const T* end,
+                      std::vector<int>* line_starts) {
+  for (auto* runner = FindLineTerminator(start, end); runner != end;
+       runner = FindLineTerminator(runner + 1, end)) {
+    line_starts->push_back(static_cast<int>(runner - start) + 1);
+  }
+}
+
+bool IsAscii(base::StringPiece input) {
+  const auto* runner = reinterpret_cast<const uint8_t*>(input.data());
+  const auto* const end = runner + input.size();
+  uint64_t bits = 0;
+  for (; end - runner >= 8; runner += 8) {
+    uint64_t word;
+    std::memcpy(&word, runner, sizeof(word));
+    bits |= word;
+  }
+  for (; runner < end; ++runner)
+    bits |= *runner;
+  return (bits & 0x8080808080808080ull) == 0;
+}
+
+// Decodes UTF-8 |input| into |output|, which has room for |input.size()|
+// characters, since one byte of UTF-8 is decoded into at most one UTF-16 code
+// unit. Returns number of UTF-16 code units written into |output|.
+size_t DecodeUtf8(base::StringPiece input, base::char16* output) {
+  const auto* runner = reinterpret_cast<const uint8_t*>(input.data());
+  const auto* const end = runner + input.size();
+  auto* writer = output;
+  while (runner < end) {
+    // Fast path for ASCII characters, we check eight bytes at once.
+    while (end - runner >= 8) {
+      uint64_t word;
+      std::memcpy(&word, runner, sizeof(word));
+      if (word & 0x8080808080808080ull)
+        break;
+      for (auto index = 0; index < 8; ++index)
+        writer[index] = runner[index];
+      runner += 8;
+      writer += 8;
+    }
+    if (runner == end)
+      break;
+    const auto lead = *runner;
+    if (lead < 0x80) {
+      *writer++ = lead;
+      ++runner;
+      continue;
+    }
+    auto length = 0;
+    uint32_t code_point = 0;
+    uint32_t min_code_point = 0;
+    if ((lead & 0xE0) == 0xC0) {
+      length = 2;
+      code_point = lead & 0x1F;
+      min_code_point = 0x80;
+    } else if ((lead & 0xF0) == 0xE0) {
+      length = 3;
+      code_point = lead & 0x0F;
+      min_code_point = 0x800;
+    } else if ((lead & 0xF8) == 0xF0) {
+      length = 4;
+      code_point = lead & 0x07;
+      min_code_point = 0x10000;
+    }
+    auto is_valid = length != 0 && end - runner >= length;
+    for (auto index = 1; is_valid && index < length; ++index) {
+      if ((runner[index] & 0xC0) != 0x80)
+        is_valid = false;
+      code_point = (code_point << 6) | (runner[index] & 0x3F);
+    }
+    if (!is_valid || code_point < min_code_point || code_point > 0x10FFFF ||
+        (code_point >= 0xD800 && code_point <= 0xDFFF)) {
+      *writer++ = kReplacementCharacter;
+      ++runner;
+      continue;
+    }
+    runner += length;
+    if (code_point < 0x10000) {
+      *writer++ = static_cast<base::char16>(code_point);
+      continue;
+    }
+    code_point -= 0x10000;
+    *writer++ = static_cast<base::char16>(0xD800 + (code_point >> 10));
+    *writer++ = static_cast<base::char16>(0xDC00 + (code_point & 0x3FF));
+  }
+  return static_cast<size_t>(writer - output);
+}
+
+}  // namespace
+
 SourceCode::Factory::Factory(Zone* zone) : zone_(*zone) {}
-SourceCode::Factory::~Factory() = default;
+
+SourceCode::Factory::~Factory() {
+  // |SourceCode| is allocated in zone, so we destroy it without freeing.
+  for (const auto* source_code : source_codes_)
+    source_code->~SourceCode();
+}
 
 const SourceCode& SourceCode::Factory::New(const base::FilePath& file_path,
                                            base::StringPiece16 file_contents) {
@@ -19,8 +129,57 @@ const SourceCode& SourceCode::Factory::New(const base::FilePath& file_path,
       zone_.AllocateObjects<base::char16>(file_contents.size());
   std::memcpy(characters, file_contents.data(),
               file_contents.size() * sizeof(base::char16));
-  return *new (&zone_) SourceCode(
-      file_path, base::StringPiece16(characters, file_contents.size()));
+  std::vector<int> line_starts;
+  RecordLineStarts(characters, characters + file_contents.size(),
+                   &line_starts);
+  return Track(new (&zone_) SourceCode(
+      &zone_, file_path, base::StringPiece16(characters, file_contents.size()),
+      line_starts));
+}
+
+const SourceCode* SourceCode::Factory::NewFromFile(
+    const base::FilePath& file_path) {
+  base::MemoryMappedFile mapped_file;
+  if (mapped_file.Initialize(file_path)) {
+    return &NewFromUtf8(
+        file_path,
+        base::StringPiece(reinterpret_cast<const char*>(mapped_file.data()),
+                          mapped_file.length()));
+  }
+  // We can't map empty file and non-regular file, e.g. pipe.
+  std::string file_contents;
+  if (!base::ReadFileToString(file_path, &file_contents))
+    return nullptr;
+  return &NewFromUtf8(file_path, base::StringPiece(file_contents));
+}
+
+const SourceCode& SourceCode::Factory::NewFromUtf8(
+    const base::FilePath& file_path,
+    base::StringPiece file_contents) {
+  std::vector<int> line_starts;
+  if (IsAscii(file_contents)) {
+    const auto size = file_contents.size();
+    auto* const characters = zone_.AllocateObjects<char>(size);
+    std::memcpy(characters, file_contents.data(), size);
+    const auto* const data = reinterpret_cast<const uint8_t*>(characters);
+    RecordLineStarts(data, data + size, &line_starts);
+    return Track(new (&zone_) SourceCode(
+        &zone_, file_path, base::StringPiece(characters, size), line_starts));
+  }
+  const auto capacity = file_contents.size();
+  auto* const characters = zone_.AllocateObjects<base::char16>(capacity);
+  const auto size = DecodeUtf8(file_contents, characters);
+  RecordLineStarts(characters, characters + size, &line_starts);
+  // Multi-byte sequences leave unused tail in |characters|.
+  zone_.Resize(characters, capacity * sizeof(base::char16),
+               size * sizeof(base::char16));
+  return Track(new (&zone_) SourceCode(
+      &zone_, file_path, base::StringPiece16(characters, size), line_starts));
+}
+
+const SourceCode& SourceCode::Factory::Track(SourceCode* source_code) {
+  source_codes_.push_back(source_code);
+  return *source_code;
 }
 
 }  // namespace aoba
@@ -5,12 +5,18 @@
 #ifndef AOBA_BASE_SOURCE_CODE_FACTORY_H_
 #define AOBA_BASE_SOURCE_CODE_FACTORY_H_
 
+#include <vector>
+
 #include "aoba/base/source_code.h"
 
 namespace aoba {
 
 class Zone;
 
+// Contents of |SourceCode| created by |SourceCode::Factory| are stored in
+// zone passed to constructor and live as long as the zone. |SourceCode|
+// objects are destroyed with the factory to release their offsets in
+// |SourceLocation| space, so the factory should outlive uses of them.
 class AOBA_BASE_EXPORT SourceCode::Factory {
  public:
   explicit Factory(Zone* zone);
@@ -19,7 +25,22 @@ class AOBA_BASE_EXPORT SourceCode::Factory {
   const SourceCode& New(const base::FilePath& file_path,
                         base::StringPiece16 file_contents);
 
+  // Returns |SourceCode| of contents of |file_path| decoded as UTF-8, or
+  // |nullptr| if we can't read |file_path|. The file is memory mapped and
+  // decoded into zone without intermediate copy.
+  const SourceCode* NewFromFile(const base::FilePath& file_path);
+
+  // Returns |SourceCode| of |file_contents| decoded as UTF-8. ASCII only
+  // contents are kept in one byte characters. Invalid UTF-8 sequences are
+  // replaced with U+FFFD.
+  const SourceCode& NewFromUtf8(const base::FilePath& file_path,
+                                base::StringPiece file_contents);
+
  private:
+  // Records |source_code| for destroying it with this factory.
+  const SourceCode& Track(SourceCode* source_code);
+
+  std::vector<const SourceCode*> source_codes_;
   Zone& zone_;
 
   DISALLOW_COPY_AND_ASSIGN(Factory);
@@ -0,0 +1,119 @@
+// Copyright (c) 2016 Project Vogue. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <string>
+
+#include "aoba/base/source_code_factory.h"
+
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/strings/utf_string_conversions.h"
+#include "aoba/base/memory/zone.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace aoba {
+
+class SourceCodeFactoryTest : public ::testing::Test {
+ protected:
+  SourceCodeFactoryTest();
+  ~SourceCodeFactoryTest() override = default;
+
+  SourceCode::Factory& factory() { return factory_; }
+
+  base::string16 Decode(base::StringPiece source_text);
+
+ private:
+  Zone zone_;
+  SourceCode::Factory factory_;
+
+  DISALLOW_COPY_AND_ASSIGN(SourceCodeFactoryTest);
+};
+
+SourceCodeFactoryTest::SourceCodeFactoryTest()
+    : zone_("SourceCodeFactoryTest"), factory_(&zone_) {}
+
+base::string16 SourceCodeFactoryTest::Decode(base::StringPiece source_text) {
+  base::string16 buffer;
+  return factory_.NewFromUtf8(base::FilePath(), source_text)
+      .range()
+      .GetString(&buffer)
+      .as_string();
+}
+
+TEST_F(SourceCodeFactoryTest, NewFromFile) {
+  base::ScopedTempDir temp_dir;
+  ASSERT_TRUE(temp_dir.CreateUniqueTempDir());
+  const auto& file_path = temp_dir.path().AppendASCII("foo.js");
+  const std::string contents8 = "var foo = '\xE3\x81\x82';\n";
+  ASSERT_EQ(static_cast<int>(contents8.size()),
+            base::WriteFile(file_path, contents8.data(), contents8.size()));
+
+  const auto* source_code = factory().NewFromFile(file_path);
+  ASSERT_NE(nullptr, source_code);
+  EXPECT_EQ(file_path, source_code->file_path());
+  EXPECT_FALSE(source_code->is_one_byte());
+  EXPECT_EQ(base::UTF8ToUTF16(contents8),
+            source_code->two_byte_contents().as_string());
+
+  EXPECT_EQ(nullptr, factory().NewFromFile(temp_dir.path().AppendASCII("x")));
+}
+
+TEST_F(SourceCodeFactoryTest, NewFromFileEmpty) {
+  base::ScopedTempDir temp_dir;
+  ASSERT_TRUE(temp_dir.CreateUniqueTempDir());
+  const auto& file_path = temp_dir.path().AppendASCII("empty.js");
+  ASSERT_EQ(0, base::WriteFile(file_path, "", 0));
+
+  const auto* source_code = factory().NewFromFile(file_path);
+  ASSERT_NE(nullptr, source_code);
+  EXPECT_EQ(0, source_code->size());
+}
+
+TEST_F(SourceCodeFactoryTest, NewFromUtf8OneByte) {
+  const auto& source_code =
+      factory().NewFromUtf8(base::FilePath(), "var foo = 'bar';\n");
+  EXPECT_TRUE(source_code.is_one_byte());
+  EXPECT_EQ(17, source_code.size());
+  EXPECT_EQ("var foo = 'bar';\n", source_code.one_byte_contents());
+  EXPECT_EQ('f', source_code.CharAt(4));
+  EXPECT_EQ("foo", source_code.GetOneByteString(4, 7));
+  base::string16 buffer;
+  EXPECT_EQ(base::ASCIIToUTF16("foo"),
+            source_code.GetString(4, 7, &buffer).as_string());
+
+  EXPECT_FALSE(
+      factory().NewFromUtf8(base::FilePath(), "caf\xC3\xA9").is_one_byte());
+}
+
+TEST_F(SourceCodeFactoryTest, NewFromUtf8) {
+  EXPECT_EQ(base::string16(), Decode(""));
+  EXPECT_EQ(base::ASCIIToUTF16("foo"), Decode("foo"));
+  EXPECT_EQ(base::ASCIIToUTF16("function foo() { return 1; }\n"),
+            Decode("function foo() { return 1; }\n"));
+
+  // Two, three and four bytes sequences.
+  const char* const kSamples[] = {
+      "caf\xC3\xA9",
+      "0123456\xC3\xA9" "89abcdef",
+      "\xE3\x81\x82\xE3\x81\x84",
+      "a\xF0\x9F\x98\x80z",
+  };
+  for (const auto* sample : kSamples)
+    EXPECT_EQ(base::UTF8ToUTF16(sample), Decode(sample)) << sample;
+}
+
+TEST_F(SourceCodeFactoryTest, NewFromUtf8Invalid) {
+  const base::char16 kReplacement = 0xFFFD;
+  // Unexpected continuation byte
+  EXPECT_EQ(base::string16(1, kReplacement), Decode("\x80"));
+  // Truncated sequence
+  EXPECT_EQ(base::string16(1, kReplacement) + base::ASCIIToUTF16("a"),
+            Decode("\xC3" "a"));
+  // Overlong encoding of '/'
+  EXPECT_EQ(base::string16(2, kReplacement), Decode("\xC0\xAF"));
+  // Surrogate code point
+  EXPECT_EQ(base::string16(3, kReplacement), Decode("\xED\xA0\x80"));
+}
+
+}  // namespace aoba
@@ -14,8 +14,6 @@ namespace aoba {
 // Line number starts with one.
 class AOBA_BASE_EXPORT SourceCodeLine final {
  public:
-  class Cache;
-
   SourceCodeLine(const SourceCodeLine& other);
   ~SourceCodeLine();
 
@@ -29,6 +27,7 @@ class AOBA_BASE_EXPORT SourceCodeLine final {
   bool operator!=(const SourceCodeLine& other) const;
 
  private:
+  friend class SourceCode;
   friend class SourceCodeLineTest;
 
   SourceCodeLine(const SourceCodeRange& range, int number);
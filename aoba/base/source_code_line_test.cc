@@ -7,7 +7,6 @@
 #include "base/strings/utf_string_conversions.h"
 #include "aoba/base/memory/zone.h"
 #include "aoba/base/source_code_factory.h"
-#include "aoba/base/source_code_line_cache.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
 namespace aoba {
@@ -47,68 +46,49 @@ SourceCodeLine SourceCodeLineTest::NewSourceCodeLine(
   return SourceCodeLine(source_code.Slice(start, end), number);
 }
 
-TEST_F(SourceCodeLineTest, Get) {
+TEST_F(SourceCodeLineTest, LineAt) {
   const auto& source_code = NewSourceCode("01\n34\n6789\n");
-  SourceCodeLine::Cache cache(source_code);
-
-  EXPECT_EQ(NewSourceCodeLine(source_code, 0, 3, 1), cache.Get(0));
-  EXPECT_EQ(NewSourceCodeLine(source_code, 0, 3, 1), cache.Get(1))
-      << "no cache update";
-
-  EXPECT_EQ(NewSourceCodeLine(source_code, 3, 6, 2), cache.Get(3))
-      << "populate cache";
-  EXPECT_EQ(NewSourceCodeLine(source_code, 3, 6, 2), cache.Get(4))
-      << "cache hit";
-  EXPECT_EQ(NewSourceCodeLine(source_code, 3, 6, 2), cache.Get(5))
-      << "cache hit";
-
-  EXPECT_EQ(NewSourceCodeLine(source_code, 6, 11, 3), cache.Get(6))
-      << "populate cache";
-  EXPECT_EQ(NewSourceCodeLine(source_code, 6, 11, 3), cache.Get(7)) << "scan";
-  EXPECT_EQ(NewSourceCodeLine(source_code, 6, 11, 3), cache.Get(8)) << "scan";
-  EXPECT_EQ(NewSourceCodeLine(source_code, 6, 11, 3), cache.Get(9)) << "scan";
-
-  EXPECT_EQ(NewSourceCodeLine(source_code, 0, 3, 1), cache.Get(1))
-      << "cache hit";
-  EXPECT_EQ(NewSourceCodeLine(source_code, 0, 3, 1), cache.Get(2))
-      << "cache hit";
-
-  EXPECT_EQ(NewSourceCodeLine(source_code, 6, 11, 3), cache.Get(6))
-      << "cache hit";
-  EXPECT_EQ(NewSourceCodeLine(source_code, 6, 11, 3), cache.Get(7))
-      << "cache hit";
-  EXPECT_EQ(NewSourceCodeLine(source_code, 6, 11, 3), cache.Get(8))
-      << "cache hit";
-  EXPECT_EQ(NewSourceCodeLine(source_code, 6, 11, 3), cache.Get(9))
-      << "cache hit";
+
+  EXPECT_EQ(NewSourceCodeLine(source_code, 0, 3, 1), source_code.LineAt(0));
+  EXPECT_EQ(NewSourceCodeLine(source_code, 0, 3, 1), source_code.LineAt(1));
+  EXPECT_EQ(NewSourceCodeLine(source_code, 0, 3, 1), source_code.LineAt(2));
+
+  EXPECT_EQ(NewSourceCodeLine(source_code, 3, 6, 2), source_code.LineAt(3));
+  EXPECT_EQ(NewSourceCodeLine(source_code, 3, 6, 2), source_code.LineAt(4));
+  EXPECT_EQ(NewSourceCodeLine(source_code, 3, 6, 2), source_code.LineAt(5));
+
+  EXPECT_EQ(NewSourceCodeLine(source_code, 6, 11, 3), source_code.LineAt(6));
+  EXPECT_EQ(NewSourceCodeLine(source_code, 6, 11, 3), source_code.LineAt(7));
+  EXPECT_EQ(NewSourceCodeLine(source_code, 6, 11, 3), source_code.LineAt(8));
+  EXPECT_EQ(NewSourceCodeLine(source_code, 6, 11, 3), source_code.LineAt(9));
+  EXPECT_EQ(NewSourceCodeLine(source_code, 6, 11, 3), source_code.LineAt(10));
+
+  EXPECT_EQ(NewSourceCodeLine(source_code, 11, 11, 4), source_code.LineAt(11));
 }
 
-TEST_F(SourceCodeLineTest, GetOnEmpty) {
+TEST_F(SourceCodeLineTest, LineAtOnEmpty) {
   const auto& source_code = NewSourceCode("");
-  SourceCodeLine::Cache cache(source_code);
 
-  EXPECT_EQ(NewSourceCodeLine(source_code, 0, 0, 1), cache.Get(0));
+  EXPECT_EQ(NewSourceCodeLine(source_code, 0, 0, 1), source_code.LineAt(0));
 }
 
-TEST_F(SourceCodeLineTest, GetOnNoNewline) {
+TEST_F(SourceCodeLineTest, LineAtOnNoNewline) {
   const auto& source_code = NewSourceCode("ab");
-  SourceCodeLine::Cache cache(source_code);
 
-  EXPECT_EQ(NewSourceCodeLine(source_code, 0, 2, 1), cache.Get(0));
-  EXPECT_EQ(NewSourceCodeLine(source_code, 0, 2, 1), cache.Get(1));
-  EXPECT_EQ(NewSourceCodeLine(source_code, 0, 2, 1), cache.Get(2));
+  EXPECT_EQ(NewSourceCodeLine(source_code, 0, 2, 1), source_code.LineAt(0));
+  EXPECT_EQ(NewSourceCodeLine(source_code, 0, 2, 1), source_code.LineAt(1));
+  EXPECT_EQ(NewSourceCodeLine(source_code, 0, 2, 1), source_code.LineAt(2));
 }
 
-TEST_F(SourceCodeLineTest, GetOnNoNewline2) {
+TEST_F(SourceCodeLineTest, LineAtOnNoNewline2) {
   const auto& source_code = NewSourceCode("01\n34");
-  SourceCodeLine::Cache cache(source_code);
 
-  EXPECT_EQ(NewSourceCodeLine(source_code, 0, 3, 1), cache.Get(0));
-  EXPECT_EQ(NewSourceCodeLine(source_code, 0, 3, 1), cache.Get(1));
-  EXPECT_EQ(NewSourceCodeLine(source_code, 0, 3, 1), cache.Get(2));
+  EXPECT_EQ(NewSourceCodeLine(source_code, 0, 3, 1), source_code.LineAt(0));
+  EXPECT_EQ(NewSourceCodeLine(source_code, 0, 3, 1), source_code.LineAt(1));
+  EXPECT_EQ(NewSourceCodeLine(source_code, 0, 3, 1), source_code.LineAt(2));
 
-  EXPECT_EQ(NewSourceCodeLine(source_code, 3, 5, 2), cache.Get(3));
-  EXPECT_EQ(NewSourceCodeLine(source_code, 3, 5, 2), cache.Get(4));
+  EXPECT_EQ(NewSourceCodeLine(source_code, 3, 5, 2), source_code.LineAt(3));
+  EXPECT_EQ(NewSourceCodeLine(source_code, 3, 5, 2), source_code.LineAt(4));
 }
 
 }  // namespace aoba
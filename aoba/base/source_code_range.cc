@@ -40,8 +40,9 @@ bool SourceCodeRange::Contains(int offset) const {
   return offset >= start_ && offset < end_;
 }
 
-base::StringPiece16 SourceCodeRange::GetString() const {
-  return source_code_->GetString(start_, end_);
+base::StringPiece16 SourceCodeRange::GetString(
+    base::string16* buffer) const {
+  return source_code_->GetString(start_, end_, buffer);
 }
 
 bool SourceCodeRange::IsCollapsed() const {
@@ -7,6 +7,7 @@
 
 #include <iosfwd>
 
+#include "base/strings/string16.h"
 #include "base/strings/string_piece.h"
 #include "aoba/base/base_export.h"
 
@@ -28,7 +29,9 @@ class AOBA_BASE_EXPORT SourceCodeRange final {
   int start() const { return start_; }
 
   bool Contains(int offset) const;
-  base::StringPiece16 GetString() const;
+  // Returns string of this range. See |SourceCode::GetString()| for
+  // |buffer|.
+  base::StringPiece16 GetString(base::string16* buffer) const;
   bool IsCollapsed() const;
 
   static SourceCodeRange CollapseToEnd(const SourceCodeRange& range);
@@ -0,0 +1,74 @@
+// Copyright (c) 2016 Project Vogue. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <utility>
+
+#include "aoba/base/source_code.h"
+
+#include "base/strings/utf_string_conversions.h"
+#include "aoba/base/memory/zone.h"
+#include "aoba/base/source_code_factory.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace aoba {
+
+class SourceCodeTest : public ::testing::Test {
+ protected:
+  SourceCodeTest();
+  ~SourceCodeTest() override = default;
+
+  SourceCode::Factory& factory() { return factory_; }
+
+ private:
+  Zone zone_;
+  SourceCode::Factory factory_;
+
+  DISALLOW_COPY_AND_ASSIGN(SourceCodeTest);
+};
+
+SourceCodeTest::SourceCodeTest() : zone_("SourceCodeTest"), factory_(&zone_) {}
+
+TEST_F(SourceCodeTest, LineAndColumnAt) {
+  const auto& source_code =
+      factory().NewFromUtf8(base::FilePath(), "01\n34\n6789\n");
+
+  EXPECT_EQ(4, source_code.number_of_lines());
+  EXPECT_EQ(std::make_pair(1, 0), source_code.LineAndColumnAt(0));
+  EXPECT_EQ(std::make_pair(1, 1), source_code.LineAndColumnAt(1));
+  EXPECT_EQ(std::make_pair(1, 2), source_code.LineAndColumnAt(2));
+
+  EXPECT_EQ(std::make_pair(2, 0), source_code.LineAndColumnAt(3));
+  EXPECT_EQ(std::make_pair(2, 1), source_code.LineAndColumnAt(4));
+  EXPECT_EQ(std::make_pair(2, 2), source_code.LineAndColumnAt(5));
+
+  EXPECT_EQ(std::make_pair(3, 0), source_code.LineAndColumnAt(6));
+  EXPECT_EQ(std::make_pair(3, 3), source_code.LineAndColumnAt(9));
+  EXPECT_EQ(std::make_pair(4, 0), source_code.LineAndColumnAt(11));
+}
+
+TEST_F(SourceCodeTest, LineAndColumnAtTwoByte) {
+  // "\xC3\xA9" is U+00E9 and "\xE2\x80\xA8" is U+2028 LINE SEPARATOR.
+  const auto& source_code = factory().NewFromUtf8(
+      base::FilePath(), "\xC3\xA9\r\n\xE2\x80\xA8" "abc\xF0\x9F\x98\x80x");
+
+  EXPECT_FALSE(source_code.is_one_byte());
+  EXPECT_EQ(4, source_code.number_of_lines());
+  EXPECT_EQ(std::make_pair(1, 1), source_code.LineAndColumnAt(1));
+  EXPECT_EQ(std::make_pair(2, 0), source_code.LineAndColumnAt(2));
+  EXPECT_EQ(std::make_pair(3, 0), source_code.LineAndColumnAt(3));
+  EXPECT_EQ(std::make_pair(4, 0), source_code.LineAndColumnAt(4));
+  EXPECT_EQ(std::make_pair(4, 5), source_code.LineAndColumnAt(9));
+}
+
+TEST_F(SourceCodeTest, LineAndColumnAtUtf16) {
+  const auto& source_code16 = base::UTF8ToUTF16("a\nb\rc");
+  const auto& source_code =
+      factory().New(base::FilePath(), base::StringPiece16(source_code16));
+
+  EXPECT_EQ(3, source_code.number_of_lines());
+  EXPECT_EQ(std::make_pair(2, 0), source_code.LineAndColumnAt(2));
+  EXPECT_EQ(std::make_pair(3, 1), source_code.LineAndColumnAt(5));
+}
+
+}  // namespace aoba
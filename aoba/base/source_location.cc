@@ -0,0 +1,189 @@
+// Copyright (c) 2016 Project Vogue. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <iterator>
+#include <limits>
+#include <ostream>
+#include <vector>
+
+#include "aoba/base/source_location.h"
+
+#include "base/logging.h"
+#include "base/macros.h"
+#include "base/memory/singleton.h"
+#include "base/synchronization/lock.h"
+#include "base/threading/thread_local.h"
+#include "aoba/base/source_code.h"
+#include "aoba/base/source_code_range.h"
+
+namespace aoba {
+
+namespace {
+
+// Fields except for |start| and |limit| are updated when the entry is
+// reused, while other threads may read them via |last_entry_|. Those threads
+// never find offsets of reused entry in stale values, since offsets of other
+// source code are outside of |[start, limit]|.
+struct Entry {
+  uint32_t start;
+  // The last offset reserved by this entry.
+  uint32_t limit;
+  std::atomic<uint32_t> end;
+  std::atomic<const SourceCode*> source_code;
+
+  Entry(uint32_t start, uint32_t end, const SourceCode* source_code)
+      : start(start), limit(end), end(end), source_code(source_code) {}
+};
+
+//
+// SourceCodeTable
+//
+class SourceCodeTable final {
+ public:
+  static SourceCodeTable* GetInstance();
+
+  // Returns entry of |SourceCode| containing |offset|.
+  const Entry& EntryOf(uint32_t offset);
+
+  uint32_t Register(const SourceCode* source_code, size_t size);
+  void Unregister(uint32_t start);
+
+ private:
+  friend struct base::DefaultSingletonTraits<SourceCodeTable>;
+
+  SourceCodeTable() = default;
+  ~SourceCodeTable() = default;
+
+  // Entries in ascending order of |start|. |std::deque| keeps addresses of
+  // entries for |last_entry_|. Entries of destroyed |SourceCode| are kept
+  // in |free_entries_| for reusing their offsets.
+  std::deque<Entry> entries_;
+  std::vector<Entry*> free_entries_;
+
+  // The entry found by the last |EntryOf()| on current thread. Most lookups
+  // are for nodes of source code parsed or checked on the thread.
+  base::ThreadLocalPointer<const Entry> last_entry_;
+
+  base::Lock lock_;
+  uint32_t next_start_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(SourceCodeTable);
+};
+
+// static
+SourceCodeTable* SourceCodeTable::GetInstance() {
+  // Locations should be valid during process exit.
+  return base::Singleton<SourceCodeTable,
+                         base::LeakySingletonTraits<SourceCodeTable>>::get();
+}
+
+const Entry& SourceCodeTable::EntryOf(uint32_t offset) {
+  const auto* const last_entry = last_entry_.Get();
+  if (last_entry && offset >= last_entry->start &&
+      offset <= last_entry->end.load(std::memory_order_relaxed)) {
+    return *last_entry;
+  }
+  base::AutoLock lock(lock_);
+  const auto it =
+      std::upper_bound(entries_.begin(), entries_.end(), offset,
+                       [](uint32_t value, const Entry& entry) {
+                         return value < entry.start;
+                       });
+  DCHECK(it != entries_.begin()) << offset;
+  const auto& entry = *std::prev(it);
+  DCHECK_LE(offset, entry.end.load(std::memory_order_relaxed));
+  DCHECK(entry.source_code.load(std::memory_order_relaxed)) << offset;
+  last_entry_.Set(&entry);
+  return entry;
+}
+
+uint32_t SourceCodeTable::Register(const SourceCode* source_code,
+                                   size_t size) {
+  base::AutoLock lock(lock_);
+  for (auto it = free_entries_.begin(); it != free_entries_.end(); ++it) {
+    auto& entry = **it;
+    if (size > entry.limit - entry.start)
+      continue;
+    entry.end.store(static_cast<uint32_t>(entry.start + size),
+                    std::memory_order_relaxed);
+    entry.source_code.store(source_code, std::memory_order_relaxed);
+    free_entries_.erase(it);
+    return entry.start;
+  }
+  const auto start = next_start_;
+  CHECK_LT(size, std::numeric_limits<uint32_t>::max() - start)
+      << "Too much source code";
+  const auto end = static_cast<uint32_t>(start + size);
+  entries_.emplace_back(start, end, source_code);
+  // Reserve |end| for collapsed range at end of |source_code|.
+  next_start_ = end + 1;
+  return start;
+}
+
+void SourceCodeTable::Unregister(uint32_t start) {
+  base::AutoLock lock(lock_);
+  const auto it =
+      std::lower_bound(entries_.begin(), entries_.end(), start,
+                       [](const Entry& entry, uint32_t value) {
+                         return entry.start < value;
+                       });
+  DCHECK(it != entries_.end() && it->start == start) << start;
+  it->end.store(start, std::memory_order_relaxed);
+  it->source_code.store(nullptr, std::memory_order_relaxed);
+  free_entries_.push_back(&*it);
+}
+
+}  // namespace
+
+//
+// SourceLocation
+//
+SourceLocation::SourceLocation(const SourceCodeRange& range)
+    : end_(range.source_code().base_offset() + range.end()),
+      start_(range.source_code().base_offset() + range.start()) {}
+
+bool SourceLocation::operator==(const SourceLocation& other) const {
+  return start_ == other.start_ && end_ == other.end_;
+}
+
+bool SourceLocation::operator!=(const SourceLocation& other) const {
+  return !operator==(other);
+}
+
+const SourceCode& SourceLocation::source_code() const {
+  return *SourceCodeTable::GetInstance()->EntryOf(start_).source_code.load(
+      std::memory_order_relaxed);
+}
+
+SourceCodeRange SourceLocation::ToRange() const {
+  return ToRange(source_code());
+}
+
+SourceCodeRange SourceLocation::ToRange(const SourceCode& source_code) const {
+  DCHECK_EQ(&source_code, &this->source_code());
+  return source_code.Slice(
+      static_cast<int>(start_ - source_code.base_offset()),
+      static_cast<int>(end_ - source_code.base_offset()));
+}
+
+// static
+uint32_t SourceLocation::Register(const SourceCode* source_code,
+                                  size_t size) {
+  return SourceCodeTable::GetInstance()->Register(source_code, size);
+}
+
+// static
+void SourceLocation::Unregister(uint32_t start) {
+  SourceCodeTable::GetInstance()->Unregister(start);
+}
+
+std::ostream& operator<<(std::ostream& ostream,
+                         const SourceLocation& location) {
+  return ostream << location.ToRange();
+}
+
+}  // namespace aoba
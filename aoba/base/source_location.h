@@ -0,0 +1,67 @@
+// Copyright (c) 2016 Project Vogue. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef AOBA_BASE_SOURCE_LOCATION_H_
+#define AOBA_BASE_SOURCE_LOCATION_H_
+
+#include <stdint.h>
+
+#include <iosfwd>
+
+#include "aoba/base/base_export.h"
+
+namespace aoba {
+
+class SourceCode;
+class SourceCodeRange;
+
+//
+// SourceLocation is a compact form of |SourceCodeRange| stored in AST nodes.
+// Each |SourceCode| occupies its own part of process wide offset space, so
+// |SourceLocation| holds offsets in the space instead of a pointer to
+// |SourceCode|. |ToRange()| finds |SourceCode| from offsets.
+//
+class AOBA_BASE_EXPORT SourceLocation final {
+ public:
+  explicit SourceLocation(const SourceCodeRange& range);
+  SourceLocation(const SourceLocation& other) = default;
+  ~SourceLocation() = default;
+
+  SourceLocation& operator=(const SourceLocation& other) = default;
+
+  bool operator==(const SourceLocation& other) const;
+  bool operator!=(const SourceLocation& other) const;
+
+  uint32_t end() const { return end_; }
+  uint32_t start() const { return start_; }
+
+  // Returns |SourceCode| containing this location.
+  const SourceCode& source_code() const;
+
+  SourceCodeRange ToRange() const;
+
+  // Returns range in |source_code| containing this location without looking
+  // up |SourceCode|, for callers knowing source code, e.g. parsers.
+  SourceCodeRange ToRange(const SourceCode& source_code) const;
+
+ private:
+  friend class SourceCode;
+
+  // Reserves offsets |[start, start + size]| for |source_code| and returns
+  // |start|. Offsets released by |Unregister()| are reused.
+  static uint32_t Register(const SourceCode* source_code, size_t size);
+
+  // Releases offsets starting at |start| for destroyed |SourceCode|.
+  static void Unregister(uint32_t start);
+
+  uint32_t end_;
+  uint32_t start_;
+};
+
+AOBA_BASE_EXPORT std::ostream& operator<<(std::ostream& ostream,
+                                          const SourceLocation& location);
+
+}  // namespace aoba
+
+#endif  // AOBA_BASE_SOURCE_LOCATION_H_
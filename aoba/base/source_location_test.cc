@@ -0,0 +1,112 @@
+// Copyright (c) 2016 Project Vogue. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <sstream>
+#include <string>
+
+#include "aoba/base/source_location.h"
+
+#include "aoba/base/memory/zone.h"
+#include "aoba/base/source_code.h"
+#include "aoba/base/source_code_factory.h"
+#include "aoba/base/source_code_range.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace aoba {
+
+class SourceLocationTest : public ::testing::Test {
+ protected:
+  SourceLocationTest();
+  ~SourceLocationTest() override = default;
+
+  Zone& zone() { return zone_; }
+
+  const SourceCode& NewSourceCode(base::StringPiece source_text);
+
+ private:
+  Zone zone_;
+  SourceCode::Factory factory_;
+
+  DISALLOW_COPY_AND_ASSIGN(SourceLocationTest);
+};
+
+SourceLocationTest::SourceLocationTest()
+    : zone_("SourceLocationTest"), factory_(&zone_) {}
+
+const SourceCode& SourceLocationTest::NewSourceCode(
+    base::StringPiece source_text) {
+  return factory_.NewFromUtf8(base::FilePath(), source_text);
+}
+
+TEST_F(SourceLocationTest, Constructor) {
+  const auto& source_code = NewSourceCode("0123456789");
+  const SourceLocation location(source_code.Slice(2, 5));
+  EXPECT_EQ(source_code.base_offset() + 2, location.start());
+  EXPECT_EQ(source_code.base_offset() + 5, location.end());
+}
+
+TEST_F(SourceLocationTest, Equal) {
+  const auto& source_code = NewSourceCode("0123456789");
+  const SourceLocation location1(source_code.Slice(2, 5));
+  const SourceLocation location2(source_code.Slice(2, 5));
+  const SourceLocation location3(source_code.Slice(2, 6));
+  EXPECT_EQ(location1, location2);
+  EXPECT_NE(location1, location3);
+}
+
+TEST_F(SourceLocationTest, Printer) {
+  const auto& source_code = NewSourceCode("0123456789");
+  const auto& range = source_code.Slice(2, 5);
+  std::ostringstream expected;
+  expected << range;
+  std::ostringstream ostream;
+  ostream << SourceLocation(range);
+  EXPECT_EQ(expected.str(), ostream.str());
+}
+
+TEST_F(SourceLocationTest, ToRange) {
+  const auto& source_code1 = NewSourceCode("0123456789");
+  const auto& source_code2 = NewSourceCode("abc");
+  const auto& source_code3 = NewSourceCode("");
+  EXPECT_NE(source_code1.base_offset(), source_code2.base_offset());
+  EXPECT_NE(source_code2.base_offset(), source_code3.base_offset());
+
+  EXPECT_EQ(source_code1.Slice(2, 5),
+            SourceLocation(source_code1.Slice(2, 5)).ToRange());
+  EXPECT_EQ(source_code2.Slice(1, 3),
+            SourceLocation(source_code2.Slice(1, 3)).ToRange());
+  EXPECT_EQ(source_code1.end(), SourceLocation(source_code1.end()).ToRange())
+      << "Collapsed range at end belongs to its source code.";
+  EXPECT_EQ(source_code2.start(),
+            SourceLocation(source_code2.start()).ToRange());
+  EXPECT_EQ(source_code3.range(),
+            SourceLocation(source_code3.range()).ToRange());
+  EXPECT_EQ(&source_code2,
+            &SourceLocation(source_code2.Slice(1, 2)).source_code());
+}
+
+TEST_F(SourceLocationTest, Reuse) {
+  // Other tests don't free offsets for such large source code.
+  const auto& source_text = std::string(1024 * 1024, 'x');
+  uint32_t base_offset = 0;
+  {
+    SourceCode::Factory factory(&zone());
+    base_offset =
+        factory.NewFromUtf8(base::FilePath(), source_text).base_offset();
+  }
+  const auto& source_code = NewSourceCode(source_text.substr(1));
+  EXPECT_EQ(base_offset, source_code.base_offset())
+      << "Offsets of destroyed source code are reused.";
+  EXPECT_EQ(source_code.Slice(1, 3),
+            SourceLocation(source_code.Slice(1, 3)).ToRange());
+  EXPECT_EQ(&source_code, &SourceLocation(source_code.end()).source_code());
+}
+
+TEST_F(SourceLocationTest, ToRangeWithSourceCode) {
+  const auto& source_code = NewSourceCode("0123456789");
+  EXPECT_EQ(source_code.Slice(2, 5),
+            SourceLocation(source_code.Slice(2, 5)).ToRange(source_code));
+}
+
+}  // namespace aoba
@@ -3,6 +3,7 @@
 // found in the LICENSE file.
 
 #include <algorithm>
+#include <iomanip>
 #include <iostream>
 #include <string>
 #include <unordered_map>
@@ -18,6 +19,7 @@
 #include "base/strings/string_piece.h"
 #include "base/strings/string_split.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/sys_info.h"
 #include "aoba/analyzer/error_codes.h"
 #include "aoba/analyzer/public/analyzer.h"
 #include "aoba/analyzer/public/analyzer_settings.h"
@@ -25,14 +27,16 @@
 #include "aoba/ast/node.h"
 #include "aoba/ast/node_factory.h"
 #include "aoba/base/error_sink.h"
+#include "aoba/base/memory/segment_pool.h"
 #include "aoba/base/memory/zone.h"
 #include "aoba/base/memory/zone_allocated.h"
+#include "aoba/base/memory/zone_registry.h"
 #include "aoba/base/source_code.h"
 #include "aoba/base/source_code_factory.h"
 #include "aoba/base/source_code_line.h"
-#include "aoba/base/source_code_line_cache.h"
 #include "aoba/base/source_code_range.h"
 #include "aoba/checker/externs_module.h"
+#include "aoba/checker/source_code_loader.h"
 #include "aoba/parser/public/parse.h"
 #include "aoba/parser/public/parser_context_builder.h"
 #include "aoba/parser/public/parser_options_builder.h"
@@ -110,7 +114,6 @@ class ScriptModule final {
   const SourceCode& source_code() const { return source_code_; }
 
  private:
-  const std::unique_ptr<SourceCodeLine::Cache> line_cache_;
   const ast::Node& root_node_;
   const SourceCode& source_code_;
 
@@ -119,17 +122,17 @@ class ScriptModule final {
 
 ScriptModule::ScriptModule(const SourceCode& source_code,
                            const ast::Node& root_node)
-    : line_cache_(new SourceCodeLine::Cache(source_code)),
-      root_node_(root_node),
+    : root_node_(root_node),
       source_code_(source_code) {}
 
 SourceCodeLine ScriptModule::SourceCodeLinetAt(int offset) const {
-  return line_cache_->Get(offset);
+  return source_code_.LineAt(offset);
 }
 
 void PrintSourceCodeLine(int start, int end, const SourceCodeRange& range) {
-  for (const auto& ch :
-       base::UTF16ToUTF8(range.source_code().GetString(start, end))) {
+  base::string16 buffer;
+  for (const auto& ch : base::UTF16ToUTF8(
+           range.source_code().GetString(start, end, &buffer))) {
     if (ch == '\t') {
       std::cout << ' ';
       continue;
@@ -179,6 +182,36 @@ void PrintSourceCodeRange(const SourceCodeLine& start_line,
                       range);
 }
 
+// Prints memory usage of zones for "--memory-stats".
+void PrintMemoryStats() {
+  const auto kNameWidth = 24;
+  const auto kNumberWidth = 14;
+  std::cout << std::left << std::setw(kNameWidth) << "Zone" << std::right
+            << std::setw(kNumberWidth) << "Requested"
+            << std::setw(kNumberWidth) << "Reserved"
+            << std::setw(kNumberWidth) << "Segments"
+            << std::setw(kNumberWidth) << "Tail waste" << std::endl;
+  ZoneStats total;
+  for (const auto& entry : ZoneRegistry::GetInstance()->Snapshot()) {
+    const auto& stats = entry.second;
+    std::cout << std::left << std::setw(kNameWidth) << entry.first
+              << std::right << std::setw(kNumberWidth)
+              << stats.bytes_requested << std::setw(kNumberWidth)
+              << stats.bytes_reserved << std::setw(kNumberWidth)
+              << stats.number_of_segments << std::setw(kNumberWidth)
+              << stats.tail_waste << std::endl;
+    total += stats;
+  }
+  std::cout << std::left << std::setw(kNameWidth) << "Total" << std::right
+            << std::setw(kNumberWidth) << total.bytes_requested
+            << std::setw(kNumberWidth) << total.bytes_reserved
+            << std::setw(kNumberWidth) << total.number_of_segments
+            << std::setw(kNumberWidth) << total.tail_waste << std::endl;
+  std::cout << std::left << std::setw(kNameWidth) << "Pooled segments"
+            << std::right << std::setw(kNumberWidth * 2)
+            << SegmentPool::GetInstance()->pooled_bytes() << std::endl;
+}
+
 //
 // Checker
 //
@@ -187,11 +220,10 @@ class Checker final {
   static int Main();
 
  private:
-  explicit Checker(const ParserOptions& options);
+  Checker(const ParserOptions& options, Zone::Backing node_zone_backing);
   ~Checker() = default;
 
-  void AddSourceCode(const base::FilePath& file_path,
-                     base::StringPiece16 file_contents);
+  void AddSourceCode(const SourceCode& source_code);
 
   void Analyze();
 
@@ -213,8 +245,9 @@ class Checker final {
   DISALLOW_COPY_AND_ASSIGN(Checker);
 };
 
-Checker::Checker(const ParserOptions& options)
-    : node_zone_("Checker.Node"),
+Checker::Checker(const ParserOptions& options,
+                 Zone::Backing node_zone_backing)
+    : node_zone_("Checker.Node", node_zone_backing),
       node_factory_(&node_zone_),
       context_(ParserContext::Builder()
                    .set_error_sink(&error_sink_)
@@ -224,9 +257,7 @@ Checker::Checker(const ParserOptions& options)
       source_code_factory_(&source_code_zone_),
       options_(options) {}
 
-void Checker::AddSourceCode(const base::FilePath& file_path,
-                            base::StringPiece16 file_contents) {
-  const auto& source_code = source_code_factory_.New(file_path, file_contents);
+void Checker::AddSourceCode(const SourceCode& source_code) {
   source_codes_.push_back(&source_code);
   const auto& module = Parse(context_.get(), source_code.range(), options_);
   modules_.push_back(&module);
@@ -281,43 +312,54 @@ int Checker::Main() {
               command_line->HasSwitch("enable_strict_backslash"))
           .set_enable_strict_regexp(
               command_line->HasSwitch("enable_strict_regexp"))
+          .set_number_of_lexer_threads(base::SysInfo::NumberOfProcessors())
           .Build();
 
-  Checker checker(options);
+  // Large source code, e.g. emscripten output, makes hundreds of MB of AST
+  // nodes. Huge pages reduce TLB misses on traversing them.
+  Checker checker(options, command_line->HasSwitch("huge-pages")
+                               ? Zone::Backing::HugePages
+                               : Zone::Backing::Heap);
 
   if (!command_line->HasSwitch("no-standard-externs")) {
     const auto& externs_module = GetEcmascriptExtens();
     for (const auto& externs_file : externs_module.files) {
-      const auto& contents16 = base::UTF8ToUTF16(
-          base::StringPiece(externs_file.content, externs_file.content_size));
       DVLOG(0) << "Standard externs " << externs_file.name;
-      checker.AddSourceCode(
+      checker.AddSourceCode(checker.source_code_factory_.NewFromUtf8(
           base::FilePath(base::UTF8ToUTF16(externs_file.name)),
-          base::StringPiece16(contents16));
+          base::StringPiece(externs_file.content, externs_file.content_size)));
     }
   }
 
-  for (const auto& file_name : command_line->GetArgs()) {
-    const auto& file_path =
-        base::MakeAbsoluteFilePath(base::FilePath(file_name));
-    std::string file_contents8;
-    if (!base::ReadFileToString(file_path, &file_contents8)) {
-      LOG(ERROR) << "Cannot read file " << file_path.value();
-      continue;
-    }
-    VLOG(0) << "Process " << file_path.value();
-    if (file_contents8.find("\n<include ") != std::string::npos) {
-      VLOG(0) << "Ignore " << file_path.value() << " contains <include>";
-      continue;
-    }
-    if (file_contents8.find("\n<if ") != std::string::npos) {
-      VLOG(0) << "Ignore " << file_path.value() << " contains <include>";
-      continue;
+  std::vector<base::FilePath> file_paths;
+  for (const auto& file_name : command_line->GetArgs())
+    file_paths.push_back(base::MakeAbsoluteFilePath(base::FilePath(file_name)));
+
+  // Files are loaded on worker threads while we parse loaded files in order
+  // of |file_paths|.
+  SourceCodeLoader loader(file_paths, base::SysInfo::NumberOfProcessors());
+  while (const auto* entry = loader.Next()) {
+    const auto& file_path = entry->file_path;
+    switch (entry->status) {
+      case SourceCodeLoader::Status::Failed:
+        LOG(ERROR) << "Cannot read file " << file_path.value();
+        continue;
+      case SourceCodeLoader::Status::Ignored:
+        VLOG(0) << "Ignore " << file_path.value() << " contains <include>";
+        continue;
+      case SourceCodeLoader::Status::Loaded:
+        VLOG(0) << "Process " << file_path.value();
+        checker.AddSourceCode(*entry->source_code);
+        continue;
+      case SourceCodeLoader::Status::Pending:
+        break;
     }
-    const auto& file_contents = base::UTF8ToUTF16(file_contents8);
-    checker.AddSourceCode(file_path, base::StringPiece16(file_contents));
+    NOTREACHED() << file_path.value();
   }
-  return checker.Run();
+  const auto exit_code = checker.Run();
+  if (command_line->HasSwitch("memory-stats"))
+    PrintMemoryStats();
+  return exit_code;
 }
 
 int Checker::Run() {
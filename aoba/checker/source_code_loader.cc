@@ -0,0 +1,156 @@
+// Copyright (c) 2016 Project Vogue. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <algorithm>
+
+#include "aoba/checker/source_code_loader.h"
+
+#include "base/logging.h"
+#include "base/strings/string_piece.h"
+#include "base/strings/utf_string_conversions.h"
+#include "base/threading/simple_thread.h"
+#include "aoba/base/memory/zone.h"
+#include "aoba/base/source_code.h"
+#include "aoba/base/source_code_factory.h"
+
+namespace aoba {
+namespace internal {
+
+namespace {
+
+// Returns true if |source_code| is a template for GRIT, which contains
+// "<include>" or "<if>" directive.
+bool HasGritDirective(const SourceCode& source_code) {
+  const char kInclude[] = "\n<include ";
+  const char kIf[] = "\n<if ";
+  if (source_code.is_one_byte()) {
+    const auto& contents = source_code.one_byte_contents();
+    return contents.find(kInclude) != base::StringPiece::npos ||
+           contents.find(kIf) != base::StringPiece::npos;
+  }
+  const auto& contents = source_code.two_byte_contents();
+  return contents.find(base::ASCIIToUTF16(kInclude)) !=
+             base::StringPiece16::npos ||
+         contents.find(base::ASCIIToUTF16(kIf)) != base::StringPiece16::npos;
+}
+
+}  // namespace
+
+//
+// SourceCodeLoader::Worker
+// Each worker has its own zone, since |Zone| isn't thread safe.
+//
+class SourceCodeLoader::Worker final
+    : public base::DelegateSimpleThread::Delegate {
+ public:
+  explicit Worker(SourceCodeLoader* loader);
+  ~Worker() final;
+
+  void Join() { thread_.Join(); }
+  void Start() { thread_.Start(); }
+
+ private:
+  // base::DelegateSimpleThread::Delegate
+  void Run() final;
+
+  SourceCodeLoader& loader_;
+  Zone zone_;
+  SourceCode::Factory factory_;
+  base::DelegateSimpleThread thread_;
+
+  DISALLOW_COPY_AND_ASSIGN(Worker);
+};
+
+SourceCodeLoader::Worker::Worker(SourceCodeLoader* loader)
+    : loader_(*loader),
+      zone_("SourceCodeLoader"),
+      factory_(&zone_),
+      thread_(this, "SourceCodeLoader") {}
+
+SourceCodeLoader::Worker::~Worker() = default;
+
+void SourceCodeLoader::Worker::Run() {
+  while (auto* entry = loader_.Take()) {
+    const auto* source_code = factory_.NewFromFile(entry->file_path);
+    if (!source_code)
+      loader_.Complete(entry, nullptr, Status::Failed);
+    else if (HasGritDirective(*source_code))
+      loader_.Complete(entry, source_code, Status::Ignored);
+    else
+      loader_.Complete(entry, source_code, Status::Loaded);
+  }
+}
+
+//
+// SourceCodeLoader::Entry
+//
+SourceCodeLoader::Entry::Entry(const base::FilePath& file_path)
+    : file_path(file_path) {}
+
+SourceCodeLoader::Entry::~Entry() = default;
+
+//
+// SourceCodeLoader
+//
+SourceCodeLoader::SourceCodeLoader(
+    const std::vector<base::FilePath>& file_paths,
+    int number_of_workers)
+    : can_take_(&lock_), loaded_(&lock_) {
+  DCHECK_GE(number_of_workers, 1);
+  entries_.reserve(file_paths.size());
+  for (const auto& file_path : file_paths)
+    entries_.emplace_back(file_path);
+  const auto size =
+      std::min(entries_.size(), static_cast<size_t>(number_of_workers));
+  for (auto index = size_t{0}; index < size; ++index)
+    workers_.emplace_back(new Worker(this));
+  for (const auto& worker : workers_)
+    worker->Start();
+}
+
+SourceCodeLoader::~SourceCodeLoader() {
+  {
+    base::AutoLock lock(lock_);
+    stopped_ = true;
+    can_take_.Broadcast();
+  }
+  for (const auto& worker : workers_)
+    worker->Join();
+}
+
+void SourceCodeLoader::Complete(Entry* entry,
+                                const SourceCode* source_code,
+                                Status status) {
+  DCHECK_NE(Status::Pending, status);
+  base::AutoLock lock(lock_);
+  entry->source_code = source_code;
+  entry->status = status;
+  loaded_.Broadcast();
+}
+
+const SourceCodeLoader::Entry* SourceCodeLoader::Next() {
+  base::AutoLock lock(lock_);
+  if (next_consume_index_ == entries_.size())
+    return nullptr;
+  auto& entry = entries_[next_consume_index_];
+  while (entry.status == Status::Pending)
+    loaded_.Wait();
+  ++next_consume_index_;
+  can_take_.Signal();
+  return &entry;
+}
+
+SourceCodeLoader::Entry* SourceCodeLoader::Take() {
+  base::AutoLock lock(lock_);
+  while (!stopped_ && next_take_index_ < entries_.size() &&
+         next_take_index_ - next_consume_index_ >= kMaxPendingFiles) {
+    can_take_.Wait();
+  }
+  if (stopped_ || next_take_index_ == entries_.size())
+    return nullptr;
+  return &entries_[next_take_index_++];
+}
+
+}  // namespace internal
+}  // namespace aoba
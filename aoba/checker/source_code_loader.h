@@ -0,0 +1,92 @@
+// Copyright (c) 2016 Project Vogue. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef AOBA_CHECKER_SOURCE_CODE_LOADER_H_
+#define AOBA_CHECKER_SOURCE_CODE_LOADER_H_
+
+#include <memory>
+#include <vector>
+
+#include "base/files/file_path.h"
+#include "base/macros.h"
+#include "base/synchronization/condition_variable.h"
+#include "base/synchronization/lock.h"
+
+namespace aoba {
+
+class SourceCode;
+
+namespace internal {
+
+//
+// SourceCodeLoader
+// Reads, screens and decodes files on worker threads, and returns them in
+// order of file paths regardless of completion order. Workers run ahead of
+// the consumer by at most |kMaxPendingFiles| files. Loaded source codes are
+// valid until the loader is destroyed.
+//
+class SourceCodeLoader final {
+ public:
+  enum class Status {
+    Pending,
+    Loaded,
+    // The file is a GRIT template containing "<include>" or "<if>".
+    Ignored,
+    Failed,
+  };
+
+  struct Entry {
+    explicit Entry(const base::FilePath& file_path);
+    ~Entry();
+
+    base::FilePath file_path;
+    const SourceCode* source_code = nullptr;
+    Status status = Status::Pending;
+  };
+
+  SourceCodeLoader(const std::vector<base::FilePath>& file_paths,
+                   int number_of_workers);
+  ~SourceCodeLoader();
+
+  // Returns next entry in order of file paths, or |nullptr| if all entries
+  // are returned. This function blocks until the entry is loaded.
+  const Entry* Next();
+
+ private:
+  class Worker;
+
+  static const size_t kMaxPendingFiles = 32;
+
+  // Called on worker thread to publish result of loading |entry|.
+  void Complete(Entry* entry, const SourceCode* source_code, Status status);
+
+  // Called on worker thread. Returns next entry to load, or |nullptr| if
+  // there are no more entries.
+  Entry* Take();
+
+  std::vector<Entry> entries_;
+  base::Lock lock_;
+
+  // Signaled when an entry is consumed or loader is stopped.
+  base::ConditionVariable can_take_;
+
+  // Signaled when an entry is loaded.
+  base::ConditionVariable loaded_;
+
+  // Index of entry to be returned by |Next()|.
+  size_t next_consume_index_ = 0;
+
+  // Index of entry to be returned by |Take()|.
+  size_t next_take_index_ = 0;
+
+  bool stopped_ = false;
+  std::vector<std::unique_ptr<Worker>> workers_;
+
+  DISALLOW_COPY_AND_ASSIGN(SourceCodeLoader);
+};
+
+}  // namespace internal
+}  // namespace aoba
+
+#endif  // AOBA_CHECKER_SOURCE_CODE_LOADER_H_
@@ -158,26 +158,32 @@ const ast::Node& JsDocParser::NewText() {
 
 // Parsing functions
 // The entry point of JsDoc parser.
+bool JsDocParser::HasBlockTag() {
+  if (first_text_end_ < 0) {
+    SkipWhitespaces();
+    first_text_start_ = location();
+    first_text_end_ = SkipToBlockTag();
+  }
+  return CanPeekChar();
+}
+
 const ast::Node* JsDocParser::Parse() {
-  NodeRangeScope scope(this);
-  SkipWhitespaces();
+  if (!HasBlockTag())
+    return nullptr;
   std::vector<const ast::Node*> nodes;
-  auto number_of_tags = 0;
-  auto text_start = location();
+  if (first_text_end_ > first_text_start_)
+    nodes.push_back(&NewText(first_text_start_, first_text_end_));
   while (CanPeekChar()) {
+    {
+      NodeRangeScope scope(this);
+      nodes.push_back(&ParseTag(ParseTagName()));
+    }
+    SkipWhitespaces();
+    const auto text_start = location();
     const auto text_end = SkipToBlockTag();
     if (text_end > text_start)
       nodes.push_back(&NewText(text_start, text_end));
-    if (!CanPeekChar())
-      break;
-    ++number_of_tags;
-    NodeRangeScope scope(this);
-    nodes.push_back(&ParseTag(ParseTagName()));
-    SkipWhitespaces();
-    text_start = location();
   }
-  if (number_of_tags == 0)
-    return nullptr;
   return &NewDocument(nodes);
 }
 
@@ -223,9 +229,7 @@ std::vector<const ast::Node*> JsDocParser::ParseNameList() {
 const ast::Node& JsDocParser::ParseName() {
   SkipWhitespaces();
   NodeRangeScope scope(this);
-  while (CanPeekChar() && IsIdentifierPart(PeekChar()))
-    ConsumeChar();
-  if (node_start_ == location()) {
+  if (reader_->ConsumeWhile(IsIdentifierPart) == 0) {
     AddError(JsDocErrorCode::ERROR_TAG_EXPECT_NAME);
     return node_factory().NewEmpty(ComputeNodeRange());
   }
@@ -323,8 +327,7 @@ const ast::Node& JsDocParser::ParseTagName() {
   DCHECK_EQ(PeekChar(), '@');
   NodeRangeScope scope(this);
   ConsumeChar();
-  while (CanPeekChar() && IsIdentifierPart(PeekChar()))
-    ConsumeChar();
+  reader_->ConsumeWhile(IsIdentifierPart);
   return NewTagName();
 }
 
@@ -362,6 +365,26 @@ const ast::Node& JsDocParser::ParseType() {
 
 int JsDocParser::SkipToBlockTag() {
   SkipWhitespaces();
+  const auto range_end = reader_->range().end();
+  if (reader_->FindChar('@') == range_end) {
+    // There are no more tags, the rest of document is text. Text ends after
+    // the last non-whitespace character, or after the first "{" of trailing
+    // "{"s as state machine below.
+    const auto text_start = reader_->location();
+    auto text_end = range_end;
+    while (text_end > text_start &&
+           IsWhitespace(source_code().CharAt(text_end - 1))) {
+      --text_end;
+    }
+    if (text_end > text_start && source_code().CharAt(text_end - 1) == '{') {
+      while (text_end - 1 > text_start &&
+             source_code().CharAt(text_end - 2) == '{') {
+        --text_end;
+      }
+    }
+    reader_->MoveTo(range_end);
+    return text_end;
+  }
   enum class State {
     Brace,
     InlineTag,
@@ -421,10 +444,9 @@ int JsDocParser::SkipToBlockTag() {
 }
 
 void JsDocParser::SkipWhitespaces() {
-  while (CanPeekChar() && IsWhitespace(PeekChar()) &&
-         !IsLineTerminator(PeekChar())) {
-    ConsumeChar();
-  }
+  reader_->ConsumeWhile([](base::char16 char_code) {
+    return IsWhitespace(char_code) && !IsLineTerminator(char_code);
+  });
 }
 
 }  // namespace parser
@@ -38,6 +38,14 @@ class JsDocParser final {
               const ParserOptions& options);
   ~JsDocParser();
 
+  // Returns true if document has a block tag, e.g. "@param". This function
+  // does not create nodes, so |Lexer| can tell JsDoc document from comment
+  // before parser takes the token. |Parse()| resumes from the first block tag
+  // instead of scanning text before it again.
+  bool HasBlockTag();
+
+  // Returns |JsDocDocument| or |nullptr| if document has no block tags.
+  // This function should be called at most once.
   const ast::Node* Parse();
 
  private:
@@ -96,6 +104,11 @@ class JsDocParser final {
   void SkipWhitespaces();
 
   ParserContext& context_;
+
+  // Text before the first block tag, set by |HasBlockTag()|.
+  int first_text_end_ = -1;
+  int first_text_start_ = -1;
+
   int node_start_;
   const ParserOptions& options_;
   std::unique_ptr<CharacterReader> reader_;
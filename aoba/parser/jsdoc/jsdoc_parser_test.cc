@@ -53,6 +53,26 @@ TEST_F(JsDocParserTest, Empty) {
   EXPECT_EQ("", Parse(""));
 }
 
+TEST_F(JsDocParserTest, HasBlockTag) {
+  PrepareSouceCode("foo {@code bar} @const");
+  JsDocParser parser(&context(), source_code().range(), ParserOptions());
+  EXPECT_TRUE(parser.HasBlockTag());
+  const auto* const document = parser.Parse();
+  ASSERT_TRUE(document) << "Parse() resumes from the first block tag";
+  std::ostringstream ostream;
+  ostream << AsPrintableTree(*document);
+  EXPECT_EQ(
+      "JsDocDocument\n"
+      "+--JsDocText |foo {@code bar}|\n"
+      "+--JsDocTag\n"
+      "|  +--Name |@const|",
+      ostream.str());
+  PrepareSouceCode("Ctrl+@foo {@code bar}");
+  EXPECT_FALSE(JsDocParser(&context(), source_code().range(), ParserOptions())
+                   .HasBlockTag());
+  EXPECT_TRUE(error_sink().errors().empty());
+}
+
 TEST_F(JsDocParserTest, InlineTag) {
   EXPECT_EQ(
       "JsDocDocument\n"
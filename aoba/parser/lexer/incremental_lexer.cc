@@ -0,0 +1,107 @@
+// Copyright (c) 2016 Project Vogue. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <limits>
+
+#include "aoba/parser/lexer/incremental_lexer.h"
+
+#include "base/logging.h"
+#include "aoba/base/source_code.h"
+#include "aoba/parser/lexer/lexer.h"
+#include "aoba/parser/lexer/parallel_lexer.h"
+#include "aoba/parser/public/parser_context.h"
+#include "aoba/parser/public/parser_context_builder.h"
+
+namespace aoba {
+namespace parser {
+
+IncrementalLexer::IncrementalLexer(ParserContext* context,
+                                   const ParserOptions& options)
+    : context_(*context),
+      lexer_context_(ParserContext::Builder()
+                         .set_error_sink(this)
+                         .set_node_factory(&context->node_factory())
+                         .Build()),
+      options_(options) {}
+
+IncrementalLexer::~IncrementalLexer() = default;
+
+void IncrementalLexer::AddError(const SourceCodeRange& range,
+                                int error_code) {
+  errors_.emplace_back(range, error_code);
+}
+
+void IncrementalLexer::Lex(const SourceCode& source_code) {
+  tokens_.Shrink(0);
+  Relex(source_code, 0, std::numeric_limits<int>::max(), 0);
+}
+
+IncrementalLexer::Span IncrementalLexer::Relex(const SourceCode& source_code,
+                                               size_t start,
+                                               int sync_start,
+                                               int delta) {
+  auto scan_start = ScanStartOf(start);
+  Lexer lexer(lexer_context_.get(),
+              source_code.Slice(scan_start, source_code.size()), options_,
+              nullptr);
+  auto index = start;
+  auto end = tokens_.size();
+  while (lexer.CanPeekToken()) {
+    const auto last = lexer.tokens().size() - 1;
+    if (scan_start >= sync_start) {
+      while (index < tokens_.size() && ScanStartOf(index) + delta < scan_start)
+        ++index;
+      if (index < tokens_.size() &&
+          ScanStartOf(index) + delta == scan_start) {
+        // Errors of this token were reported when it was lexed before.
+        lexer.tokens_.Shrink(last);
+        end = index;
+        break;
+      }
+    }
+    for (const auto& error : errors_)
+      context_.error_sink().AddError(error.first, error.second);
+    errors_.clear();
+    scan_start = lexer.tokens().end_of(last);
+    lexer.SkipToken();
+  }
+  if (end == tokens_.size()) {
+    for (const auto& error : errors_)
+      context_.error_sink().AddError(error.first, error.second);
+  }
+  errors_.clear();
+  const auto& new_tokens = lexer.tokens();
+  tokens_.Replace(start, end, new_tokens, delta);
+  return Span{start, end, start + new_tokens.size()};
+}
+
+int IncrementalLexer::ScanStartOf(size_t index) const {
+  return index == 0 ? 0 : tokens_.end_of(index - 1);
+}
+
+IncrementalLexer::Span IncrementalLexer::Update(const SourceCode& source_code,
+                                                int offset,
+                                                int removed_length,
+                                                int inserted_length) {
+  DCHECK_GE(offset, 0);
+  DCHECK_GE(removed_length, 0);
+  DCHECK_GE(inserted_length, 0);
+  DCHECK_LE(offset + inserted_length, source_code.size());
+  // Since scanning a token looks one character after its end, we re-lex
+  // from the first token ending at or after |offset|.
+  auto start = size_t{0};
+  auto end = tokens_.size();
+  while (start < end) {
+    const auto middle = start + (end - start) / 2;
+    if (tokens_.end_of(middle) < offset)
+      start = middle + 1;
+    else
+      end = middle;
+  }
+  return Relex(source_code, start, offset + inserted_length,
+               inserted_length - removed_length);
+}
+
+}  // namespace parser
+}  // namespace aoba
@@ -0,0 +1,97 @@
+// Copyright (c) 2016 Project Vogue. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef AOBA_PARSER_LEXER_INCREMENTAL_LEXER_H_
+#define AOBA_PARSER_LEXER_INCREMENTAL_LEXER_H_
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "base/macros.h"
+#include "aoba/base/error_sink.h"
+#include "aoba/base/source_code_range.h"
+#include "aoba/parser/lexer/token_buffer.h"
+#include "aoba/parser/public/parser_options.h"
+
+namespace aoba {
+
+class ParserContext;
+class SourceCode;
+
+namespace parser {
+
+//
+// IncrementalLexer
+// Holds tokens of source code for editors, and updates them after an edit
+// by re-lexing tokens from the last token ending before the edit until a
+// token starts at the offset where a previous token started scanning. Since
+// scanning a token depends only on characters from its start offset to one
+// character after its end, remaining tokens are same as previous tokens
+// moved by length difference of the edit.
+//
+// Tokens are lexed without regular expressions, since only parser knows
+// whether "/" starts a regular expression.
+//
+class IncrementalLexer final : public ErrorSink {
+ public:
+  // Tokens in [|start|, |old_end|) of previous tokens are replaced with
+  // tokens in [|start|, |new_end|).
+  struct Span {
+    size_t start;
+    size_t old_end;
+    size_t new_end;
+  };
+
+  IncrementalLexer(ParserContext* context, const ParserOptions& options);
+  ~IncrementalLexer();
+
+  const TokenBuffer& tokens() const { return tokens_; }
+
+  // Lexes whole |source_code|.
+  void Lex(const SourceCode& source_code);
+
+  // Updates tokens for |source_code|, which is source code of previous call
+  // with |removed_length| characters at |offset| replaced by
+  // |inserted_length| characters, and returns changed span of tokens. Only
+  // errors of re-lexed tokens are reported.
+  Span Update(const SourceCode& source_code,
+              int offset,
+              int removed_length,
+              int inserted_length);
+
+ private:
+  // ErrorSink
+  void AddError(const SourceCodeRange& range, int error_code) final;
+
+  // Lexes |source_code| from where token at |start| started scanning until
+  // a token starts scanning at or after |sync_start| where a token in
+  // |tokens_| started scanning before moving by |delta|, and replaces
+  // changed tokens.
+  Span Relex(const SourceCode& source_code,
+             size_t start,
+             int sync_start,
+             int delta);
+
+  // Returns offset where token at |index| started scanning, including
+  // whitespaces and comments before token.
+  int ScanStartOf(size_t index) const;
+
+  ParserContext& context_;
+  const std::unique_ptr<ParserContext> lexer_context_;
+
+  // Errors of token being scanned by |Relex()|, which are reported when the
+  // token is taken.
+  std::vector<std::pair<SourceCodeRange, int>> errors_;
+
+  const ParserOptions options_;
+  TokenBuffer tokens_;
+
+  DISALLOW_COPY_AND_ASSIGN(IncrementalLexer);
+};
+
+}  // namespace parser
+}  // namespace aoba
+
+#endif  // AOBA_PARSER_LEXER_INCREMENTAL_LEXER_H_
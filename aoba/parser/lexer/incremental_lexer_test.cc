@@ -0,0 +1,116 @@
+// Copyright (c) 2016 Project Vogue. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <sstream>
+#include <string>
+
+#include "aoba/parser/lexer/incremental_lexer.h"
+
+#include "base/macros.h"
+#include "aoba/ast/tokens.h"
+#include "aoba/base/source_code.h"
+#include "aoba/parser/public/parser_options.h"
+#include "aoba/testing/lexer_test_base.h"
+
+namespace aoba {
+namespace parser {
+
+//
+// IncrementalLexerTest
+//
+class IncrementalLexerTest : public LexerTestBase {
+ protected:
+  IncrementalLexerTest() = default;
+  ~IncrementalLexerTest() override = default;
+
+  // Replaces |removed_length| characters at |offset| of |source_text| by
+  // |inserted_text|, and returns changed span of tokens if updated tokens
+  // are same as tokens lexed from scratch.
+  std::string Update(const std::string& source_text,
+                     int offset,
+                     int removed_length,
+                     const std::string& inserted_text);
+
+ private:
+  static std::string ToString(const TokenBuffer& tokens);
+
+  DISALLOW_COPY_AND_ASSIGN(IncrementalLexerTest);
+};
+
+std::string IncrementalLexerTest::ToString(const TokenBuffer& tokens) {
+  std::ostringstream ostream;
+  for (auto index = size_t{0}; index < tokens.size(); ++index) {
+    ostream << (tokens.is_separated_by_newline(index) ? '\n' : ' ')
+            << tokens.kind_of(index) << '@' << tokens.start_of(index) << '-'
+            << tokens.end_of(index);
+  }
+  return ostream.str();
+}
+
+std::string IncrementalLexerTest::Update(const std::string& source_text,
+                                         int offset,
+                                         int removed_length,
+                                         const std::string& inserted_text) {
+  IncrementalLexer lexer(&context(), ParserOptions());
+  PrepareSouceCode(source_text);
+  lexer.Lex(source_code());
+
+  auto new_source_text = source_text;
+  new_source_text.replace(offset, removed_length, inserted_text);
+  PrepareSouceCode(new_source_text);
+  const auto& span =
+      lexer.Update(source_code(), offset, removed_length,
+                   static_cast<int>(inserted_text.size()));
+
+  IncrementalLexer expected_lexer(&context(), ParserOptions());
+  expected_lexer.Lex(source_code());
+  const auto& actual = ToString(lexer.tokens());
+  const auto& expected = ToString(expected_lexer.tokens());
+  if (actual != expected)
+    return "Expected:" + expected + "\nActual:" + actual;
+  std::ostringstream ostream;
+  ostream << '[' << span.start << ", " << span.old_end << ") => [" << span.start
+          << ", " << span.new_end << ')';
+  return ostream.str();
+}
+
+TEST_F(IncrementalLexerTest, Update) {
+  const auto& source_text = std::string("var abc = 12;\nfoo(abc);\n");
+  EXPECT_EQ("[1, 2) => [1, 2)", Update(source_text, 4, 0, "x"))
+      << "Insert at start of token";
+  EXPECT_EQ("[1, 2) => [1, 2)", Update(source_text, 7, 0, "d"))
+      << "Insert at end of token";
+  EXPECT_EQ("[1, 2) => [1, 3)", Update(source_text, 5, 0, " "))
+      << "Split token";
+  EXPECT_EQ("[1, 4) => [1, 2)", Update(source_text, 7, 3, ""))
+      << "Join tokens";
+  EXPECT_EQ("[3, 4) => [3, 4)", Update(source_text, 11, 1, "3.5"));
+  EXPECT_EQ("[4, 6) => [4, 6)", Update(source_text, 13, 1, "\n\n"))
+      << "Newline before token";
+  EXPECT_EQ("[0, 1) => [0, 1)", Update(source_text, 0, 0, " "));
+  EXPECT_EQ("[10, 10) => [10, 12)", Update(source_text, 24, 0, "x;"))
+      << "Append";
+}
+
+TEST_F(IncrementalLexerTest, UpdateComment) {
+  const auto& source_text = std::string("a = 1;\nb = 2;\nc = 3;\n");
+  EXPECT_EQ("[0, 12) => [0, 1)", Update(source_text, 0, 0, "/*"))
+      << "Unclosed comment";
+  EXPECT_EQ("[3, 12) => [3, 6)", Update(source_text, 6, 0, "/*x*/ /*"))
+      << "Comment before token";
+  EXPECT_EQ("[0, 5) => [0, 2)", Update(source_text, 0, 0, "//"));
+  EXPECT_EQ("[3, 12) => [3, 5)", Update(source_text, 6, 0, "`"))
+      << "Unclosed template literal";
+}
+
+TEST_F(IncrementalLexerTest, UpdateString) {
+  const auto& source_text = std::string("x = 'a b';\ny = \"c\";\n");
+  EXPECT_EQ("[2, 8) => [2, 5)", Update(source_text, 4, 1, ""))
+      << "Remove opening quote";
+  EXPECT_EQ("[2, 8) => [2, 4)", Update(source_text, 8, 0, "'"))
+      << "Add closing quote";
+}
+
+}  // namespace parser
+}  // namespace aoba
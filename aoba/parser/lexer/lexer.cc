@@ -4,12 +4,13 @@
 
 #include <stdint.h>
 
-#include <cmath>
-#include <limits>
-#include <vector>
+#include <memory>
+#include <string>
+#include <utility>
 
 #include "aoba/parser/lexer/lexer.h"
 
+#include "base/strings/string_number_conversions.h"
 #include "aoba/ast/error_codes.h"
 #include "aoba/ast/literals.h"
 #include "aoba/ast/node_factory.h"
@@ -19,8 +20,10 @@
 #include "aoba/base/source_code_range.h"
 #include "aoba/parser/jsdoc/jsdoc_parser.h"
 #include "aoba/parser/lexer/lexer_error_codes.h"
+#include "aoba/parser/lexer/parallel_lexer.h"
 #include "aoba/parser/public/parse.h"
 #include "aoba/parser/utils/character_reader.h"
+#include "aoba/parser/utils/decimal_to_double.h"
 #include "aoba/parser/utils/lexer_utils.h"
 
 namespace aoba {
@@ -28,23 +31,70 @@ namespace parser {
 
 namespace {
 
-const auto kMaxIntegerPart = static_cast<uint64_t>(1) << 53;
+// We stop accumulating exponent part at |kMaxExponentPart|, which is far
+// beyond range of double even with long significand.
+const auto kMaxExponentPart = 100000000;
+// 10^19 - 1 fits in |uint64_t|.
+const auto kMaxSignificantDigits = 19;
+
+// Returns correctly rounded value of decimal digits with an optional decimal
+// point between |start| and |end| times 10^|exponent|. This is used for
+// rare case that |DecimalToDouble()| can't handle.
+double SlowDecimalToDouble(const SourceCode& source_code,
+                           int start,
+                           int end,
+                           int exponent) {
+  std::string text;
+  for (auto offset = start; offset < end; ++offset)
+    text.push_back(static_cast<char>(source_code.CharAt(offset)));
+  text.push_back('e');
+  text.append(base::IntToString(exponent));
+  auto value = 0.0;
+  // |base::StringToDouble()| returns false on overflow and underflow, but
+  // |value| is still correctly rounded.
+  ignore_result(base::StringToDouble(text, &value));
+  return value;
+}
+
+std::unique_ptr<ParallelLexer> NewParallelLexerIfNeeded(
+    const SourceCodeRange& range,
+    const ParserOptions& options) {
+  if (options.number_of_lexer_threads() <= 1 ||
+      range.end() - range.start() < ParallelLexer::kMinSourceSize) {
+    return nullptr;
+  }
+  return std::unique_ptr<ParallelLexer>(
+      new ParallelLexer(range, options, options.number_of_lexer_threads()));
+}
 
 }  // namespace
 
 Lexer::Lexer(ParserContext* context,
              const SourceCodeRange& range,
              const ParserOptions& options)
+    : Lexer(context, range, options, NewParallelLexerIfNeeded(range, options)) {
+}
+
+Lexer::Lexer(ParserContext* context,
+             const SourceCodeRange& range,
+             const ParserOptions& options,
+             std::unique_ptr<ParallelLexer> parallel_lexer)
     : context_(*context),
       options_(options),
+      parallel_lexer_(std::move(parallel_lexer)),
       range_(range),
       reader_(new CharacterReader(range)),
       token_start_(range.start()) {
-  current_token_ = NextToken();
+  has_token_ = NextToken();
 }
 
 Lexer::~Lexer() = default;
 
+bool Lexer::is_separated_by_newline() const {
+  DCHECK(has_token_);
+  return tokens_.is_separated_by_newline(tokens_.size() - 1);
+}
+
 SourceCodeRange Lexer::location() const {
   return source_code().Slice(reader_->location(), reader_->location());
 }
@@ -65,6 +115,11 @@ void Lexer::AddError(ErrorCode error_code) {
   AddError(MakeTokenRange(), error_code);
 }
 
+void Lexer::AddToken(ast::SyntaxCode syntax, ast::TokenKind kind) {
+  tokens_.Add(syntax, kind, token_start_, reader_->location(),
+              is_separated_by_newline_);
+}
+
 bool Lexer::CanPeekChar() const {
   return reader_->CanPeekChar();
 }
@@ -78,17 +133,17 @@ bool Lexer::ConsumeCharIf(base::char16 char_code) {
 }
 
 const ast::Node& Lexer::ConsumeToken() {
-  DCHECK(current_token_);
-  auto& token = *current_token_;
-  current_token_ = NextToken();
+  auto& token = PeekToken();
+  SkipToken();
   return token;
 }
 
 // Replaces current "/" or "/=" token with |RegExpSource|.
 const ast::Node& Lexer::ExtendTokenAsRegExp() {
-  DCHECK(PeekToken() == ast::TokenKind::Divide ||
-         PeekToken() == ast::TokenKind::DivideEqual);
-  token_start_ = PeekToken().range().start();
+  DCHECK(PeekTokenIs(ast::TokenKind::Divide) ||
+         PeekTokenIs(ast::TokenKind::DivideEqual));
+  token_start_ = tokens_.start_of(tokens_.size() - 1);
+  tokens_.Shrink(tokens_.size() - 1);
   enum class State {
     Backslash,
     Bracket,
@@ -124,122 +179,147 @@ const ast::Node& Lexer::ExtendTokenAsRegExp() {
           continue;
         }
         if (char_code == '/') {
-          current_token_ = &node_factory().NewRegExpSource(MakeTokenRange());
-          return *current_token_;
+          AddToken(ast::SyntaxCode::RegExpSource);
+          current_node_ = &node_factory().NewRegExpSource(MakeTokenRange());
+          return *current_node_;
         }
         continue;
     }
     NOTREACHED() << "We should handle state=" << static_cast<int>(state);
   }
   AddError(ErrorCode::REGEXP_EXPECT_SLASH);
-  current_token_ = &node_factory().NewRegExpSource(MakeTokenRange());
-  return *current_token_;
+  AddToken(ast::SyntaxCode::RegExpSource);
+  current_node_ = &node_factory().NewRegExpSource(MakeTokenRange());
+  return *current_node_;
 }
 
 base::char16 Lexer::PeekChar() const {
   return reader_->PeekChar();
 }
 
-const ast::Node& Lexer::PeekToken() const {
-  DCHECK(current_token_);
-  return *current_token_;
+const ast::Node& Lexer::PeekToken() {
+  DCHECK(has_token_);
+  if (!current_node_)
+    current_node_ = &NewNode();
+  return *current_node_;
 }
 
-const ast::Node& Lexer::HandleBlockComment() {
-  auto is_jsdoc = CanPeekChar() && PeekChar() == '*';
-  auto is_after_asterisk = false;
-  while (CanPeekChar()) {
-    if (is_after_asterisk && ConsumeCharIf('/')) {
-      const auto range = MakeTokenRange();
-      if (!is_jsdoc)
-        return node_factory().NewComment(range);
-      const auto* const document =
-          JsDocParser(&context_, range, options_).Parse();
-      if (document)
-        return *document;
-      return node_factory().NewComment(range);
-    }
-    if (IsLineTerminator(PeekChar()))
-      is_separated_by_newline_ = true;
-    is_after_asterisk = ConsumeChar() == '*';
+bool Lexer::PeekTokenIs(ast::TokenKind kind) const {
+  DCHECK(has_token_);
+  return tokens_.Is(tokens_.size() - 1, kind);
+}
+
+bool Lexer::PeekTokenIs(ast::SyntaxCode syntax) const {
+  DCHECK(has_token_);
+  return tokens_.syntax_of(tokens_.size() - 1) == syntax;
+}
+
+ast::TokenKind Lexer::PeekTokenKind() const {
+  DCHECK(has_token_);
+  return tokens_.kind_of(tokens_.size() - 1);
+}
+
+SourceCodeRange Lexer::PeekTokenRange() const {
+  DCHECK(has_token_);
+  const auto index = tokens_.size() - 1;
+  return source_code().Slice(tokens_.start_of(index), tokens_.end_of(index));
+}
+
+void Lexer::HandleBlockComment() {
+  const auto is_jsdoc = CanPeekChar() && PeekChar() == '*';
+  const auto comment_end = reader_->FindBlockCommentEnd();
+  if (reader_->HasLineTerminatorBefore(comment_end))
+    is_separated_by_newline_ = true;
+  reader_->MoveTo(comment_end);
+  if (!ConsumeCharIf('/')) {
+    AddError(ErrorCode::BLOCK_COMMENT_NOT_CLOSED);
+    return AddToken(ast::SyntaxCode::Comment);
   }
-  AddError(ErrorCode::BLOCK_COMMENT_NOT_CLOSED);
-  return node_factory().NewComment(MakeTokenRange());
+  if (!is_jsdoc)
+    return AddToken(ast::SyntaxCode::Comment);
+  // We parse JsDoc document in |NewNode()| when parser takes or skips it, so
+  // every JsDoc document is parsed once in |Parser::Run()|.
+  auto jsdoc_parser =
+      std::make_unique<JsDocParser>(&context_, MakeTokenRange(), options_);
+  if (!jsdoc_parser->HasBlockTag())
+    return AddToken(ast::SyntaxCode::Comment);
+  jsdoc_parser_ = std::move(jsdoc_parser);
+  AddToken(ast::SyntaxCode::JsDocDocument);
 }
 
-const ast::Node* Lexer::HandleCharacter() {
+void Lexer::HandleCharacter() {
   token_start_ = reader_->location();
   switch (PeekChar()) {
     case '!':
       ConsumeChar();
       if (ConsumeCharIf('=')) {
         if (ConsumeCharIf('='))
-          return &NewPunctuator(ast::TokenKind::NotEqualEqual);
-        return &NewPunctuator(ast::TokenKind::NotEqual);
+          return NewPunctuator(ast::TokenKind::NotEqualEqual);
+        return NewPunctuator(ast::TokenKind::NotEqual);
       }
-      return &NewPunctuator(ast::TokenKind::LogicalNot);
+      return NewPunctuator(ast::TokenKind::LogicalNot);
     case '"':
-      return &HandleStringLiteral();
+      return HandleStringLiteral();
     case '$':
-      return &HandleName();
+      return HandleName();
     case '%':
-      return &HandleOperator(ast::TokenKind::Modulo, ast::TokenKind::Invalid,
+      return HandleOperator(ast::TokenKind::Modulo, ast::TokenKind::Invalid,
                              ast::TokenKind::ModuloEqual);
     case '&':
-      return &HandleOperator(ast::TokenKind::BitAnd, ast::TokenKind::LogicalAnd,
+      return HandleOperator(ast::TokenKind::BitAnd, ast::TokenKind::LogicalAnd,
                              ast::TokenKind::BitAndEqual);
     case '\'':
-      return &HandleStringLiteral();
+      return HandleStringLiteral();
     case '(':
       ConsumeChar();
-      return &NewPunctuator(ast::TokenKind::LeftParenthesis);
+      return NewPunctuator(ast::TokenKind::LeftParenthesis);
     case ')':
       ConsumeChar();
-      return &NewPunctuator(ast::TokenKind::RightParenthesis);
+      return NewPunctuator(ast::TokenKind::RightParenthesis);
     case '*':
       ConsumeChar();
       if (ConsumeCharIf('='))
-        return &NewPunctuator(ast::TokenKind::TimesEqual);
+        return NewPunctuator(ast::TokenKind::TimesEqual);
       if (ConsumeCharIf('*')) {
         if (ConsumeCharIf('='))
-          return &NewPunctuator(ast::TokenKind::TimesTimesEqual);
-        return &NewPunctuator(ast::TokenKind::TimesTimes);
+          return NewPunctuator(ast::TokenKind::TimesTimesEqual);
+        return NewPunctuator(ast::TokenKind::TimesTimes);
       }
-      return &NewPunctuator(ast::TokenKind::Times);
+      return NewPunctuator(ast::TokenKind::Times);
     case '+':
-      return &HandleOperator(ast::TokenKind::Plus, ast::TokenKind::PlusPlus,
+      return HandleOperator(ast::TokenKind::Plus, ast::TokenKind::PlusPlus,
                              ast::TokenKind::PlusEqual);
     case ',':
       ConsumeChar();
-      return &NewPunctuator(ast::TokenKind::Comma);
+      return NewPunctuator(ast::TokenKind::Comma);
     case '-':
-      return &HandleOperator(ast::TokenKind::Minus, ast::TokenKind::MinusMinus,
+      return HandleOperator(ast::TokenKind::Minus, ast::TokenKind::MinusMinus,
                              ast::TokenKind::MinusEqual);
     case '.':
       ConsumeChar();
       if (ConsumeCharIf('.')) {
         if (ConsumeCharIf('.'))
-          return &NewPunctuator(ast::TokenKind::DotDotDot);
+          return NewPunctuator(ast::TokenKind::DotDotDot);
         AddError(ErrorCode::PUNCTUATOR_DOT_DOT);
-        return &NewPunctuator(ast::TokenKind::DotDot);
+        return NewPunctuator(ast::TokenKind::DotDot);
       }
       if (CanPeekChar() && IsDigitChar(PeekChar(), 10)) {
         reader_->MoveBackward();
-        return &HandleDecimalAfterDot(0, 0);
+        return HandleDecimal();
       }
-      return &NewPunctuator(ast::TokenKind::Dot);
+      return NewPunctuator(ast::TokenKind::Dot);
     case '/':
       ConsumeChar();
       if (ConsumeCharIf('='))
-        return &NewPunctuator(ast::TokenKind::DivideEqual);
+        return NewPunctuator(ast::TokenKind::DivideEqual);
       if (ConsumeCharIf('*'))
-        return &HandleBlockComment();
+        return HandleBlockComment();
       if (ConsumeCharIf('/'))
-        return &HandleLineComment();
-      return &NewPunctuator(ast::TokenKind::Divide);
+        return HandleLineComment();
+      return NewPunctuator(ast::TokenKind::Divide);
     case '0':
       ConsumeChar();
-      return &HandleDigitZero();
+      return HandleDigitZero();
     case '1':
     case '2':
     case '3':
@@ -249,156 +329,161 @@ const ast::Node* Lexer::HandleCharacter() {
     case '7':
     case '8':
     case '9':
-      return &HandleDecimal();
+      return HandleDecimal();
     case ':':
       ConsumeChar();
-      return &NewPunctuator(ast::TokenKind::Colon);
+      return NewPunctuator(ast::TokenKind::Colon);
     case ';':
       ConsumeChar();
-      return &NewPunctuator(ast::TokenKind::Semicolon);
+      return NewPunctuator(ast::TokenKind::Semicolon);
     case '<':
       ConsumeChar();
       if (ConsumeCharIf('='))
-        return &NewPunctuator(ast::TokenKind::LessThanOrEqual);
+        return NewPunctuator(ast::TokenKind::LessThanOrEqual);
       if (ConsumeCharIf('<')) {
         if (ConsumeCharIf('='))
-          return &NewPunctuator(ast::TokenKind::LeftShiftEqual);
-        return &NewPunctuator(ast::TokenKind::LeftShift);
+          return NewPunctuator(ast::TokenKind::LeftShiftEqual);
+        return NewPunctuator(ast::TokenKind::LeftShift);
       }
-      return &NewPunctuator(ast::TokenKind::LessThan);
+      return NewPunctuator(ast::TokenKind::LessThan);
     case '=':
       ConsumeChar();
       if (ConsumeCharIf('=')) {
         if (ConsumeCharIf('='))
-          return &NewPunctuator(ast::TokenKind::EqualEqualEqual);
-        return &NewPunctuator(ast::TokenKind::EqualEqual);
+          return NewPunctuator(ast::TokenKind::EqualEqualEqual);
+        return NewPunctuator(ast::TokenKind::EqualEqual);
       }
       if (ConsumeCharIf('>'))
-        return &NewPunctuator(ast::TokenKind::Arrow);
-      return &NewPunctuator(ast::TokenKind::Equal);
+        return NewPunctuator(ast::TokenKind::Arrow);
+      return NewPunctuator(ast::TokenKind::Equal);
     case '>':
       ConsumeChar();
       if (ConsumeCharIf('='))
-        return &NewPunctuator(ast::TokenKind::GreaterThanOrEqual);
+        return NewPunctuator(ast::TokenKind::GreaterThanOrEqual);
       if (ConsumeCharIf('>')) {
         if (ConsumeCharIf('='))
-          return &NewPunctuator(ast::TokenKind::RightShiftEqual);
+          return NewPunctuator(ast::TokenKind::RightShiftEqual);
         if (ConsumeCharIf('>')) {
           if (ConsumeCharIf('='))
-            return &NewPunctuator(ast::TokenKind::UnsignedRightShiftEqual);
-          return &NewPunctuator(ast::TokenKind::UnsignedRightShift);
+            return NewPunctuator(ast::TokenKind::UnsignedRightShiftEqual);
+          return NewPunctuator(ast::TokenKind::UnsignedRightShift);
         }
-        return &NewPunctuator(ast::TokenKind::RightShift);
+        return NewPunctuator(ast::TokenKind::RightShift);
       }
-      return &NewPunctuator(ast::TokenKind::GreaterThan);
+      return NewPunctuator(ast::TokenKind::GreaterThan);
     case '?':
       ConsumeChar();
-      return &NewPunctuator(ast::TokenKind::Question);
+      return NewPunctuator(ast::TokenKind::Question);
     case '`':
       // TODO(eval1749): NYI: template token
-      return &HandleStringLiteral();
+      return HandleStringLiteral();
     case '[':
       ConsumeChar();
-      return &NewPunctuator(ast::TokenKind::LeftBracket);
+      return NewPunctuator(ast::TokenKind::LeftBracket);
     case ']':
       ConsumeChar();
-      return &NewPunctuator(ast::TokenKind::RightBracket);
+      return NewPunctuator(ast::TokenKind::RightBracket);
     case '_':
-      return &HandleName();
+      return HandleName();
     case '^':
-      return &HandleOperator(ast::TokenKind::BitXor, ast::TokenKind::Invalid,
+      return HandleOperator(ast::TokenKind::BitXor, ast::TokenKind::Invalid,
                              ast::TokenKind::BitXorEqual);
     case '~':
       ConsumeChar();
-      return &NewPunctuator(ast::TokenKind::BitNot);
+      return NewPunctuator(ast::TokenKind::BitNot);
     case '{':
       ConsumeChar();
-      return &NewPunctuator(ast::TokenKind::LeftBrace);
+      return NewPunctuator(ast::TokenKind::LeftBrace);
     case '}':
       ConsumeChar();
-      return &NewPunctuator(ast::TokenKind::RightBrace);
+      return NewPunctuator(ast::TokenKind::RightBrace);
     case '|':
-      return &HandleOperator(ast::TokenKind::BitOr, ast::TokenKind::LogicalOr,
+      return HandleOperator(ast::TokenKind::BitOr, ast::TokenKind::LogicalOr,
                              ast::TokenKind::BitOrEqual);
   }
   if (IsIdentifierStart(PeekChar()))
-    return &HandleName();
+    return HandleName();
   if (IsWhitespace(PeekChar())) {
     ConsumeChar();
-    return nullptr;
+    return;
   }
   ConsumeChar();
   AddError(ErrorCode::CHARACTER_INVALID);
-  return nullptr;
 }
 
-const ast::Node& Lexer::HandleDecimal() {
-  uint64_t integer_part = FromDigitChar(ConsumeChar(), 10);
-  auto integer_scale = 0;
-  while (CanPeekChar()) {
-    if (!IsDigitChar(PeekChar(), 10))
-      break;
-    const auto digit = FromDigitChar(ConsumeChar(), 10);
-    if (integer_part > std::numeric_limits<uint64_t>::max() / 10 - digit) {
-      ++integer_scale;
-      continue;
+void Lexer::HandleDecimal() {
+  // We accumulate at most |kMaxSignificantDigits| digits, which fit in
+  // |uint64_t|, and remember whether we drop non-zero digits or not.
+  uint64_t significand = 0;
+  auto number_of_digits = 0;
+  auto exponent = 0;
+  auto is_truncated = false;
+  auto is_fraction = false;
+  const auto accumulate = [&](base::char16 char_code) {
+    if (!IsDigitChar(char_code, 10))
+      return false;
+    const auto digit = FromDigitChar(char_code, 10);
+    if (number_of_digits == kMaxSignificantDigits) {
+      if (!is_fraction)
+        ++exponent;
+      is_truncated |= digit != 0;
+      return true;
     }
-    integer_part *= 10;
-    integer_part += digit;
-  }
-  return HandleDecimalAfterDot(integer_part, integer_scale);
-}
-
-const ast::Node& Lexer::HandleDecimalAfterDot(uint64_t integer_part,
-                                              int integer_scale) {
-  auto digits_part = integer_part;
-  auto digits_scale = integer_scale;
+    if (is_fraction)
+      --exponent;
+    significand *= 10;
+    significand += digit;
+    if (significand != 0)
+      ++number_of_digits;
+    return true;
+  };
+  reader_->ConsumeWhile(accumulate);
   if (ConsumeCharIf('.')) {
-    while (CanPeekChar()) {
-      if (!IsDigitChar(PeekChar(), 10))
-        break;
-      const auto digit = FromDigitChar(ConsumeChar(), 10);
-      if (digits_part > kMaxIntegerPart) {
-        // Since we've already had number of digits more than precision, just
-        // ignore digit digits_part decimal point.
-        continue;
-      }
-      --digits_scale;
-      digits_part *= 10;
-      digits_part += digit;
-    }
+    is_fraction = true;
+    reader_->ConsumeWhile(accumulate);
   }
-  uint64_t exponent_part = 0;
-  auto exponent_sign = 0;
+  const auto significand_end = reader_->location();
+  auto exponent_part = 0;
+  auto exponent_sign = 1;
   if (ConsumeCharIf('E') || ConsumeCharIf('e')) {
     if (ConsumeCharIf('+'))
       exponent_sign = 1;
     else if (ConsumeCharIf('-'))
       exponent_sign = -1;
-    while (CanPeekChar()) {
-      if (!IsDigitChar(PeekChar(), 10))
-        break;
-      const auto digit = FromDigitChar(ConsumeChar(), 10);
-      if (exponent_part > kMaxIntegerPart)
-        continue;
-      exponent_part *= 10;
-      exponent_part += digit;
-    }
+    reader_->ConsumeWhile([&](base::char16 char_code) {
+      if (!IsDigitChar(char_code, 10))
+        return false;
+      // Larger exponent makes infinity or zero anyway.
+      if (exponent_part < kMaxExponentPart) {
+        exponent_part *= 10;
+        exponent_part += FromDigitChar(char_code, 10);
+      }
+      return true;
+    });
   }
-  auto invalid_start = reader_->location();
-  while (CanPeekChar() && IsIdentifierPart(PeekChar()))
-    ConsumeChar();
-  if (reader_->location() > invalid_start) {
+  const auto invalid_start = reader_->location();
+  if (reader_->ConsumeWhile(IsIdentifierPart) > 0) {
     AddError(RangeFrom(invalid_start),
              ErrorCode::NUMERIC_LITERAL_DECIMAL_BAD_DIGIT);
   }
-  const auto value =
-      static_cast<double>(digits_part) * std::pow(10.0, digits_scale);
-  const auto exponent = exponent_part * exponent_sign;
-  return NewNumericLiteral(value * std::pow(10.0, exponent));
+  exponent_part *= exponent_sign;
+
+  // When we drop digits, value is between |significand| and |significand|
+  // plus one. If both round to same double, it is the value.
+  auto value = 0.0;
+  auto upper_value = 0.0;
+  if (DecimalToDouble(significand, exponent + exponent_part, &value) &&
+      (!is_truncated || (DecimalToDouble(significand + 1,
+                                         exponent + exponent_part,
+                                         &upper_value) &&
+                         value == upper_value))) {
+    return NewNumericLiteral(value);
+  }
+  return NewNumericLiteral(SlowDecimalToDouble(
+      source_code(), token_start_, significand_end, exponent_part));
 }
 
-const ast::Node& Lexer::HandleDigitZero() {
+void Lexer::HandleDigitZero() {
   if (!CanPeekChar())
     return NewNumericLiteral(0);
   switch (PeekChar()) {
@@ -411,9 +496,9 @@ const ast::Node& Lexer::HandleDigitZero() {
     case '6':
     case '7': {
       // Continue fetching octal digits
-      auto& token = HandleInteger(8);
+      HandleInteger(8);
       AddError(ErrorCode::NUMERIC_LITERAL_INTEGER_OCTAL);
-      return token;
+      return;
     }
     case '8':
     case '9':
@@ -431,32 +516,32 @@ const ast::Node& Lexer::HandleDigitZero() {
       ConsumeChar();
       return HandleInteger(16);
   }
-  return HandleDecimalAfterDot(0, 0);
+  return HandleDecimal();
 }
 
-const ast::Node& Lexer::HandleInteger(int base) {
+void Lexer::HandleInteger(int base) {
   DCHECK(base == 2 || base == 8 || base == 16) << base;
   uint64_t accumulator = 0;
   const auto kMaxInteger = static_cast<uint64_t>(1) << 53;
-  auto number_of_digits = 0;
   auto is_overflow = false;
-  while (CanPeekChar() && IsDigitChar(PeekChar(), base)) {
-    const auto digit = FromDigitChar(ConsumeChar(), base);
-    if (digit != 0 && accumulator > kMaxInteger / base) {
-      if (!is_overflow)
-        AddError(ErrorCode::NUMERIC_LITERAL_INTEGER_OVERFLOW);
-      is_overflow = true;
-    } else {
-      accumulator *= base;
-      accumulator += digit;
-    }
-    ++number_of_digits;
-  }
+  const auto number_of_digits =
+      reader_->ConsumeWhile([&](base::char16 char_code) {
+        if (!IsDigitChar(char_code, base))
+          return false;
+        const auto digit = FromDigitChar(char_code, base);
+        if (digit != 0 && accumulator > kMaxInteger / base) {
+          is_overflow = true;
+          return true;
+        }
+        accumulator *= base;
+        accumulator += digit;
+        return true;
+      });
+  if (is_overflow)
+    AddError(ErrorCode::NUMERIC_LITERAL_INTEGER_OVERFLOW);
 
   const auto invalid_start = reader_->location();
-  while (CanPeekChar() && IsIdentifierPart(PeekChar()))
-    ConsumeChar();
-  if (reader_->location() > invalid_start) {
+  if (reader_->ConsumeWhile(IsIdentifierPart) > 0) {
     AddError(RangeFrom(invalid_start),
              ErrorCode::NUMERIC_LITERAL_INTEGER_BAD_DIGIT);
   } else if (number_of_digits == 0) {
@@ -465,29 +550,24 @@ const ast::Node& Lexer::HandleInteger(int base) {
   return NewNumericLiteral(accumulator);
 }
 
-const ast::Node& Lexer::HandleLineComment() {
-  while (CanPeekChar()) {
-    if (IsLineTerminator(ConsumeChar())) {
-      is_separated_by_newline_ = true;
-      break;
-    }
+void Lexer::HandleLineComment() {
+  reader_->MoveTo(reader_->FindLineTerminator());
+  if (CanPeekChar()) {
+    ConsumeChar();
+    is_separated_by_newline_ = true;
   }
-  return node_factory().NewComment(MakeTokenRange());
+  AddToken(ast::SyntaxCode::Comment);
 }
 
-const ast::Node& Lexer::HandleName() {
-  while (CanPeekChar()) {
-    if (!IsIdentifierPart(PeekChar()))
-      break;
-    ConsumeChar();
-  }
-  return node_factory().NewName(MakeTokenRange());
+void Lexer::HandleName() {
+  reader_->ConsumeWhile(IsIdentifierPart);
+  AddToken(ast::SyntaxCode::Name, ast::NodeFactory::NameIdOf(MakeTokenRange()));
 }
 
 // Handle op, op op, op '=' pattern.
-const ast::Node& Lexer::HandleOperator(ast::TokenKind one,
-                                       ast::TokenKind two,
-                                       ast::TokenKind equal) {
+void Lexer::HandleOperator(ast::TokenKind one,
+                           ast::TokenKind two,
+                           ast::TokenKind equal) {
   const auto char_code = ConsumeChar();
   if (ConsumeCharIf('='))
     return NewPunctuator(equal);
@@ -496,8 +576,7 @@ const ast::Node& Lexer::HandleOperator(ast::TokenKind one,
   return NewPunctuator(one);
 }
 
-const ast::Node& Lexer::HandleStringLiteral() {
-  std::vector<base::char16> characters;
+void Lexer::HandleStringLiteral() {
   enum class State {
     Backslash,
     BackslashCr,
@@ -512,14 +591,23 @@ const ast::Node& Lexer::HandleStringLiteral() {
     Normal,
   } state = State::Normal;
   const auto delimiter = ConsumeChar();
-  auto accumulator = 0;
+  // Code point of "\u{...}", which stops growing after it exceeds
+  // |kMaxUnicodeCodePoint|.
+  auto code_point = uint32_t{0};
   auto backslash_start = 0;
   while (CanPeekChar()) {
     switch (state) {
       case State::Normal:
-        if (ConsumeCharIf(delimiter)) {
-          return node_factory().NewStringLiteral(MakeTokenRange());
-        }
+        // Characters other than delimiter, backslash and line terminator
+        // stand for themselves, so we skip them without copying.
+        reader_->ConsumeWhile([&](base::char16 char_code) {
+          return char_code != delimiter && char_code != '\\' &&
+                 !IsLineTerminator(char_code);
+        });
+        if (!CanPeekChar())
+          continue;
+        if (ConsumeCharIf(delimiter))
+          return AddToken(ast::SyntaxCode::StringLiteral);
         if (PeekChar() == '\\') {
           backslash_start = reader_->location();
           state = State::Backslash;
@@ -527,7 +615,6 @@ const ast::Node& Lexer::HandleStringLiteral() {
         }
         if (delimiter != '`' && IsLineTerminator(PeekChar()))
           AddError(RangeFrom(token_start_), ErrorCode::STRING_LITERAL_NEWLINE);
-        characters.push_back(PeekChar());
         break;
       case State::Backslash:
         switch (PeekChar()) {
@@ -535,7 +622,6 @@ const ast::Node& Lexer::HandleStringLiteral() {
           case '"':
           case '\\':
             state = State::Normal;
-            characters.push_back(PeekChar());
             break;
           case '0':
             ConsumeChar();
@@ -546,32 +632,25 @@ const ast::Node& Lexer::HandleStringLiteral() {
               state = State::Normal;
               continue;
             }
-            characters.push_back('\0');
             state = State::Normal;
             continue;
           case 'b':
             state = State::Normal;
-            characters.push_back('\b');
             break;
           case 'f':
             state = State::Normal;
-            characters.push_back('\f');
             break;
           case 'n':
             state = State::Normal;
-            characters.push_back('\n');
             break;
           case 'r':
             state = State::Normal;
-            characters.push_back('\r');
             break;
           case 't':
             state = State::Normal;
-            characters.push_back('\t');
             break;
           case 'v':
             state = State::Normal;
-            characters.push_back('\v');
             break;
           case '\n':
           case 0x2028:  // Line separator
@@ -588,7 +667,7 @@ const ast::Node& Lexer::HandleStringLiteral() {
             state = State::BackslashU;
             break;
           default:
-            characters.push_back(ConsumeChar());
+            ConsumeChar();
             if (options_.enable_strict_backslash()) {
               AddError(RangeFrom(backslash_start),
                        ErrorCode::STRING_LITERAL_BACKSLASH);
@@ -605,7 +684,6 @@ const ast::Node& Lexer::HandleStringLiteral() {
       case State::BackslashU:
         if (IsDigitChar(PeekChar(), 16)) {
           state = State::BackslashU1;
-          accumulator = FromDigitChar(PeekChar(), 16);
           break;
         }
         if (PeekChar() == '{') {
@@ -619,28 +697,21 @@ const ast::Node& Lexer::HandleStringLiteral() {
       case State::BackslashU1:
         if (!IsDigitChar(PeekChar(), 16))
           goto invalid_hex_digit;
-        accumulator *= 16;
-        accumulator |= FromDigitChar(PeekChar(), 16);
         state = State::BackslashU2;
         break;
       case State::BackslashU2:
         if (!IsDigitChar(PeekChar(), 16))
           goto invalid_hex_digit;
-        accumulator *= 16;
-        accumulator |= FromDigitChar(PeekChar(), 16);
         state = State::BackslashU3;
         break;
       case State::BackslashU3:
         if (!IsDigitChar(PeekChar(), 16))
           goto invalid_hex_digit;
-        accumulator *= 16;
-        accumulator |= FromDigitChar(PeekChar(), 16);
-        characters.push_back(static_cast<base::char16>(accumulator));
         state = State::Normal;
         break;
       case State::BackslashUB:
         if (IsDigitChar(PeekChar(), 16)) {
-          accumulator = FromDigitChar(PeekChar(), 16);
+          code_point = FromDigitChar(PeekChar(), 16);
           state = State::BackslashUBx;
           break;
         }
@@ -650,18 +721,16 @@ const ast::Node& Lexer::HandleStringLiteral() {
         break;
       case State::BackslashUBx:
         if (PeekChar() == '}') {
-          if (accumulator > kMaxUnicodeCodePoint) {
+          if (code_point > kMaxUnicodeCodePoint) {
             AddError(RangeFrom(backslash_start),
                      ErrorCode::STRING_LITERAL_BACKSLASH_UNICODE);
-          } else {
-            characters.push_back(static_cast<base::char16>(accumulator));
           }
           state = State::Normal;
           break;
         }
         if (IsDigitChar(PeekChar(), 16)) {
-          accumulator *= 16;
-          accumulator |= FromDigitChar(PeekChar(), 16);
+          if (code_point <= kMaxUnicodeCodePoint)
+            code_point = code_point * 16 + FromDigitChar(PeekChar(), 16);
           break;
         }
         AddError(RangeFrom(backslash_start),
@@ -671,15 +740,11 @@ const ast::Node& Lexer::HandleStringLiteral() {
       case State::BackslashX:
         if (!IsDigitChar(PeekChar(), 16))
           goto invalid_hex_digit;
-        accumulator = FromDigitChar(PeekChar(), 16);
         state = State::BackslashX1;
         break;
       case State::BackslashX1:
         if (!IsDigitChar(PeekChar(), 16))
           goto invalid_hex_digit;
-        accumulator *= 16;
-        accumulator |= FromDigitChar(PeekChar(), 16);
-        characters.push_back(static_cast<base::char16>(accumulator));
         state = State::Normal;
         break;
       invalid_hex_digit:
@@ -694,7 +759,7 @@ const ast::Node& Lexer::HandleStringLiteral() {
     ConsumeChar();
   }
   AddError(ErrorCode::STRING_LITERAL_NOT_CLOSED);
-  return node_factory().NewStringLiteral(MakeTokenRange());
+  AddToken(ast::SyntaxCode::StringLiteral);
 }
 
 SourceCodeRange Lexer::MakeTokenRange() const {
@@ -703,28 +768,100 @@ SourceCodeRange Lexer::MakeTokenRange() const {
   return source_code().Slice(token_start_, reader_->location());
 }
 
-const ast::Node& Lexer::NewNumericLiteral(double value) {
-  return node_factory().NewNumericLiteral(MakeTokenRange(), value);
+const ast::Node& Lexer::NewNode() const {
+  DCHECK(has_token_);
+  const auto index = tokens_.size() - 1;
+  const auto& range = source_code().Slice(tokens_.start_of(index),
+                                          tokens_.end_of(index));
+  switch (tokens_.syntax_of(index)) {
+    case ast::SyntaxCode::Comment:
+      return node_factory().NewComment(range);
+    case ast::SyntaxCode::JsDocDocument: {
+      // Token taken from |ParallelLexer| has no |jsdoc_parser_|.
+      const auto* const document =
+          jsdoc_parser_ ? jsdoc_parser_->Parse()
+                        : JsDocParser(&context_, range, options_).Parse();
+      DCHECK(document) << range;
+      return *document;
+    }
+    case ast::SyntaxCode::Name:
+      return node_factory().NewName(range, tokens_.kind_of(index));
+    case ast::SyntaxCode::NumericLiteral:
+      return node_factory().NewNumericLiteral(range, current_value_);
+    case ast::SyntaxCode::Punctuator:
+      return node_factory().NewPunctuator(range, tokens_.kind_of(index));
+    case ast::SyntaxCode::StringLiteral:
+      return node_factory().NewStringLiteral(range);
+    default:
+      break;
+  }
+  NOTREACHED() << "We should have a node for " << range;
+  return node_factory().NewComment(range);
 }
 
-const ast::Node& Lexer::NewPunctuator(ast::TokenKind kind) {
-  return node_factory().NewPunctuator(MakeTokenRange(), kind);
+void Lexer::NewNumericLiteral(double value) {
+  current_value_ = value;
+  AddToken(ast::SyntaxCode::NumericLiteral);
 }
 
-const ast::Node* Lexer::NextToken() {
-  is_separated_by_newline_ = false;
+void Lexer::NewPunctuator(ast::TokenKind kind) {
+  AddToken(ast::SyntaxCode::Punctuator, kind);
+}
+
+bool Lexer::NextToken() {
+  current_node_ = nullptr;
+  jsdoc_parser_.reset();
+  if (parallel_lexer_ && TakePrescannedToken())
+    return true;
+  const auto number_of_tokens = tokens_.size();
   while (CanPeekChar()) {
+    if (PeekChar() == ' ' || PeekChar() == '\t') {
+      // Skip indentation at once.
+      reader_->SkipSpaces();
+      continue;
+    }
     if (IsLineTerminator(PeekChar()))
       is_separated_by_newline_ = true;
-    if (auto* token = HandleCharacter())
-      return token;
+    HandleCharacter();
+    if (tokens_.size() != number_of_tokens)
+      return true;
   }
-  return nullptr;
+  return false;
 }
 
 SourceCodeRange Lexer::RangeFrom(int start) const {
   return source_code().Slice(start, reader_->location());
 }
 
+bool Lexer::TakePrescannedToken() {
+  const auto& tokens = parallel_lexer_->tokens();
+  const auto index = parallel_lexer_->IndexOf(reader_->location());
+  if (index == tokens.size())
+    return false;
+  parallel_lexer_->ReportErrors(index, &context_.error_sink());
+  if (tokens.syntax_of(index) == ast::SyntaxCode::NumericLiteral)
+    current_value_ = parallel_lexer_->ValueOf(index);
+  // Prescanned flag covers only characters after scan start.
+  is_separated_by_newline_ |= tokens.is_separated_by_newline(index);
+  token_start_ = tokens.start_of(index);
+  reader_->MoveTo(tokens.end_of(index));
+  AddToken(tokens.syntax_of(index), tokens.kind_of(index));
+  return true;
+}
+
+void Lexer::ResetTokenNode() {
+  DCHECK(has_token_);
+  // Since JsDoc parser reports errors while creating node, we don't reset
+  // node of JsDoc document.
+  DCHECK(!PeekTokenIs(ast::SyntaxCode::JsDocDocument));
+  current_node_ = nullptr;
+}
+
+void Lexer::SkipToken() {
+  DCHECK(has_token_);
+  is_separated_by_newline_ = false;
+  has_token_ = NextToken();
+}
+
 }  // namespace parser
 }  // namespace aoba
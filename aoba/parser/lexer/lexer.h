@@ -12,15 +12,15 @@
 #include "base/macros.h"
 #include "base/strings/string16.h"
 #include "aoba/ast/syntax_forward.h"
+#include "aoba/base/source_code_range.h"
+#include "aoba/parser/lexer/token_buffer.h"
 
 namespace aoba {
 
 class ErrorSink;
 class ParserContext;
 class ParserOptions;
-struct TokenKind;
 class SourceCode;
-class SourceCodeRange;
 
 namespace ast {
 class Node;
@@ -30,15 +30,22 @@ class NodeFactory;
 namespace parser {
 
 class CharacterReader;
+class IncrementalLexer;
+class JsDocParser;
+class ParallelLexer;
 
 //
 // Lexer
+// Scans tokens into |TokenBuffer| and creates |ast::Node| of current token
+// only when |PeekToken()| or |ConsumeToken()| is called.
 //
 class Lexer final {
  public:
   // Expose |ErrorCode| for RegExp parser.
   enum class ErrorCode;
 
+  // |Lexer| lexes large source code on worker threads if
+  // |ParserOptions::number_of_lexer_threads()| is greater than one.
   Lexer(ParserContext* context,
         const SourceCodeRange& range,
         const ParserOptions& options);
@@ -50,12 +57,16 @@ class Lexer final {
 
   // Returns true if there are at least one line terminate between current token
   // and previous token.
-  bool is_separated_by_newline() const { return is_separated_by_newline_; }
+  bool is_separated_by_newline() const;
 
   const SourceCode& source_code() const;
 
+  // Returns tokens scanned so far. The last token is current token if
+  // |CanPeekToken()| is true.
+  const TokenBuffer& tokens() const { return tokens_; }
+
   // Returns true if |Lexer| has a token.
-  bool CanPeekToken() const { return current_token_ != nullptr; }
+  bool CanPeekToken() const { return has_token_; }
 
   // Returns |ast::RegExp| after "/".
   const ast::Node& ConsumeRegExp();
@@ -65,14 +76,44 @@ class Lexer final {
   // Returns |RegExpSource| node starts with "/" or "/=", and ends with "/".
   const ast::Node& ExtendTokenAsRegExp();
 
-  const ast::Node& PeekToken() const;
+  const ast::Node& PeekToken();
+
+  // Returns true if current token is punctuator or name of |kind|.
+  bool PeekTokenIs(ast::TokenKind kind) const;
+
+  bool PeekTokenIs(ast::SyntaxCode syntax) const;
+
+  // Returns kind of current punctuator, or name id of current name.
+  ast::TokenKind PeekTokenKind() const;
+
+  SourceCodeRange PeekTokenRange() const;
+
+  // Discards |ast::Node| of current token released by
+  // |ast::NodeFactory::RewindKeeping()|. Scanned tokens are kept, and
+  // |PeekToken()| creates the node again.
+  void ResetTokenNode();
+
+  // Advances to next token without creating |ast::Node| of current token.
+  void SkipToken();
 
  private:
+  friend class IncrementalLexer;
+  friend class ParallelLexer;
+
+  Lexer(ParserContext* context,
+        const SourceCodeRange& range,
+        const ParserOptions& options,
+        std::unique_ptr<ParallelLexer> parallel_lexer);
+
   ast::NodeFactory& node_factory() const;
 
   void AddError(const SourceCodeRange& range, ErrorCode error_code);
   void AddError(ErrorCode error_code);
 
+  // Adds a token from |token_start_| to current location.
+  void AddToken(ast::SyntaxCode syntax,
+                ast::TokenKind kind = ast::TokenKind::Invalid);
+
   // Returns true if |Lexer| has a character.
   bool CanPeekChar() const;
 
@@ -84,39 +125,59 @@ class Lexer final {
 
   // Returns character.
   base::char16 PeekChar() const;
-  const ast::Node& HandleBlockComment();
-  const ast::Node* HandleCharacter();
-  const ast::Node& HandleDecimal();
-  const ast::Node& HandleDecimalAfterDot(uint64_t integer_part,
-                                         int integer_scale);
-  const ast::Node& HandleDigitZero();
-  const ast::Node& HandleInteger(int base);
-  const ast::Node& HandleLineComment();
-  const ast::Node& HandleName();
-  const ast::Node& HandleOperator(ast::TokenKind one,
-                                  ast::TokenKind two,
-                                  ast::TokenKind equal);
-  const ast::Node& HandleStringLiteral();
+  void HandleBlockComment();
+  void HandleCharacter();
+  void HandleDecimal();
+  void HandleDigitZero();
+  void HandleInteger(int base);
+  void HandleLineComment();
+  void HandleName();
+  void HandleOperator(ast::TokenKind one,
+                      ast::TokenKind two,
+                      ast::TokenKind equal);
+  void HandleStringLiteral();
 
   SourceCodeRange MakeTokenRange() const;
 
-  const ast::Node& NewNumericLiteral(double value);
-  const ast::Node& NewPunctuator(ast::TokenKind kind);
+  // Returns new |ast::Node| for current token.
+  const ast::Node& NewNode() const;
 
-  const ast::Node* NextToken();
+  void NewNumericLiteral(double value);
+  void NewPunctuator(ast::TokenKind kind);
+
+  // Returns true if we get a token.
+  bool NextToken();
 
   SourceCodeRange RangeFrom(int start) const;
 
+  // Returns true if we take a token scanned by |ParallelLexer| at current
+  // location.
+  bool TakePrescannedToken();
+
   ParserContext& context_;
-  const ast::Node* current_token_ = nullptr;
+
+  // |ast::Node| of current token. This is |nullptr| until |PeekToken()|
+  // except for RegExp source.
+  const ast::Node* current_node_ = nullptr;
+
+  // Value of current token if current token is numeric literal.
+  double current_value_ = 0;
+
+  // Parser of current token if current token is JsDoc document scanned by
+  // |HandleBlockComment()|. |NewNode()| resumes it from the first block tag.
+  std::unique_ptr<JsDocParser> jsdoc_parser_;
+
+  bool has_token_ = false;
 
   // True if current token and previous token is separated by at least one
   // line terminator.
   bool is_separated_by_newline_ = false;
   const ParserOptions& options_;
-  const SourceCodeRange& range_;
+  const std::unique_ptr<ParallelLexer> parallel_lexer_;
+  const SourceCodeRange range_;
   const std::unique_ptr<CharacterReader> reader_;
   int token_start_;
+  TokenBuffer tokens_;
 
   DISALLOW_COPY_AND_ASSIGN(Lexer);
 };
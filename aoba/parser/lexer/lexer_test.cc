@@ -2,6 +2,7 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <limits>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -73,6 +74,9 @@ class LexerTest : public LexerTestBase {
                     LexerMode mode = LexerMode::Normal);
   std::string Parse(LexerMode mode = LexerMode::Normal);
 
+  // Returns range of the first token followed by errors.
+  std::string ScanFirstToken();
+
  private:
   DISALLOW_COPY_AND_ASSIGN(LexerTest);
 };
@@ -162,6 +166,16 @@ std::string LexerTest::Parse(LexerMode mode) {
   return Parse({}, mode);
 }
 
+std::string LexerTest::ScanFirstToken() {
+  Lexer lexer(&context(), source_code().range(), ParserOptions());
+  std::ostringstream ostream;
+  const auto& range = lexer.PeekTokenRange();
+  ostream << range.start() << ':' << range.end();
+  for (const auto* error : error_sink().errors())
+    ostream << ' ' << error->error_code() << '@' << error->range();
+  return ostream.str();
+}
+
 TEST_F(LexerTest, JsDoc) {
   PrepareSouceCode("/** @type {number} */");
   const auto& document =
@@ -210,6 +224,10 @@ TEST_F(LexerTest, InvalidChar) {
   PrepareSouceCode("#");
   EXPECT_EQ(NewError(ERROR_CHARACTER_INVALID, 0, 1), Parse())
       << "Invalid character at end of source";
+
+  PrepareSouceCode("\xC2\xA9" "foo");
+  EXPECT_EQ(NewName(1, 4) + NewError(ERROR_CHARACTER_INVALID, 0, 1), Parse())
+      << "U+00A9 COPYRIGHT SIGN isn't ID_Start";
 }
 
 TEST_F(LexerTest, LineComment) {
@@ -235,6 +253,16 @@ TEST_F(LexerTest, Name) {
 
   PrepareSouceCode("while");
   EXPECT_EQ(NewName(0, 5), Parse());
+
+  PrepareSouceCode("caf\xC3\xA9");
+  EXPECT_EQ(NewName(0, 4), Parse()) << "U+00E9 is ID_Continue";
+
+  PrepareSouceCode("\xCE\xB1\xCF\x89");
+  EXPECT_EQ(NewName(0, 2), Parse()) << "Greek letters are ID_Start";
+
+  PrepareSouceCode("a\xE3\x80\x80" "b");
+  EXPECT_EQ(NewName(0, 1) + " " + NewName(2, 3), Parse())
+      << "U+3000 IDEOGRAPHIC SPACE is whitespace";
 }
 
 TEST_F(LexerTest, NodeFactoryNewName) {
@@ -342,6 +370,36 @@ TEST_F(LexerTest, NumericLiteralError) {
       << "Decimal contains letter.";
 }
 
+TEST_F(LexerTest, NumericLiteralValue) {
+  // Syntax factory shares syntax of numeric literals of same value.
+  const auto& syntax_from = [&](base::StringPiece source) {
+    PrepareSouceCode(source);
+    Lexer lexer(&context(), source_code().range(), ParserOptions());
+    return &lexer.ConsumeToken().syntax();
+  };
+  const auto& syntax_of = [&](double value) {
+    return &node_factory().NewNumericLiteral(MakeRange(), value).syntax();
+  };
+
+  EXPECT_EQ(syntax_of(0.1), syntax_from("0.1"));
+  EXPECT_EQ(syntax_of(123.456e-7), syntax_from("123.456e-7"));
+  EXPECT_EQ(syntax_of(1.7976931348623157e308),
+            syntax_from("1.7976931348623157e308"));
+  EXPECT_EQ(syntax_of(12345678901234567890.0),
+            syntax_from("12345678901234567890"))
+      << "Integer part is larger than 2^53";
+  EXPECT_EQ(syntax_of(9007199254740992.0), syntax_from("9007199254740993"))
+      << "Halfway rounds to even";
+  EXPECT_EQ(syntax_of(9007199254740994.0),
+            syntax_from("9007199254740993.0000000001"))
+      << "Dropped digits round up";
+  EXPECT_EQ(syntax_of(4.9406564584124654e-324), syntax_from("5e-324"))
+      << "Subnormal";
+  EXPECT_EQ(syntax_of(std::numeric_limits<double>::infinity()),
+            syntax_from("1e400"));
+  EXPECT_EQ(syntax_of(0), syntax_from("1e-400"));
+}
+
 TEST_F(LexerTest, Punctuator) {
   // ";"
   PrepareSouceCode(";");
@@ -492,6 +550,38 @@ TEST_F(LexerTest, StringLiteral) {
 
   PrepareSouceCode("'\\u{123}'");
   EXPECT_EQ(NewStringLiteral({0x123}), Parse());
+
+  PrepareSouceCode("'a\"b`c'");
+  EXPECT_EQ(NewStringLiteral("a\"b`c"), Parse());
+
+  PrepareSouceCode("'abc\\ndef\\\\'");
+  EXPECT_EQ(NewStringLiteral("abc\ndef\\"), Parse());
+}
+
+TEST_F(LexerTest, StringLiteralRange) {
+  PrepareSouceCode("'abc' x");
+  EXPECT_EQ("0:5", ScanFirstToken());
+
+  PrepareSouceCode("\"a'b`c\" x");
+  EXPECT_EQ("0:7", ScanFirstToken());
+
+  PrepareSouceCode("'abc\\ndef\\\\' x");
+  EXPECT_EQ("0:12", ScanFirstToken());
+
+  PrepareSouceCode("`ab\ncd` x");
+  EXPECT_EQ("0:7", ScanFirstToken())
+      << "Template literal can contain newline";
+
+  PrepareSouceCode("'ab\ncd' x");
+  EXPECT_EQ("0:7" + NewError(ERROR_STRING_LITERAL_NEWLINE, 0, 3),
+            ScanFirstToken())
+      << "Line terminator stops bulk consumed run";
+
+  PrepareSouceCode("'ab\r\ncd' x");
+  EXPECT_EQ("0:8" + NewError(ERROR_STRING_LITERAL_NEWLINE, 0, 3) +
+                NewError(ERROR_STRING_LITERAL_NEWLINE, 0, 4),
+            ScanFirstToken())
+      << "Each line terminator character is reported";
 }
 
 TEST_F(LexerTest, StringLiteralError) {
@@ -548,6 +638,21 @@ TEST_F(LexerTest, StringLiteralError) {
                 NewError(ERROR_STRING_LITERAL_BACKSLASH_HEX_DIGIT, 1, 4),
             Parse())
       << "'\\u' without hexadecimal digit";
+
+  PrepareSouceCode("'\\u{110000}'");
+  EXPECT_EQ(NewStringLiteral("") +
+                NewError(ERROR_STRING_LITERAL_BACKSLASH_UNICODE, 1, 10),
+            Parse())
+      << "'\\u{...}' out of Unicode code point";
+
+  PrepareSouceCode("'\\u{FFFFFFFFFFFFFFFF}'");
+  EXPECT_EQ(NewStringLiteral("") +
+                NewError(ERROR_STRING_LITERAL_BACKSLASH_UNICODE, 1, 20),
+            Parse())
+      << "'\\u{...}' with many hexadecimal digits";
+
+  PrepareSouceCode("'\\u{000000000010FFFF}'");
+  EXPECT_EQ(NewStringLiteral(""), Parse()) << "Leading zeros";
 }
 
 }  // namespace parser
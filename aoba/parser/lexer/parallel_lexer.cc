@@ -0,0 +1,257 @@
+// Copyright (c) 2016 Project Vogue. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <string.h>
+
+#include <algorithm>
+#include <memory>
+
+#include "aoba/parser/lexer/parallel_lexer.h"
+
+#include "base/logging.h"
+#include "base/threading/simple_thread.h"
+#include "aoba/ast/node_factory.h"
+#include "aoba/base/error_sink.h"
+#include "aoba/base/memory/zone.h"
+#include "aoba/base/source_code.h"
+#include "aoba/parser/lexer/lexer.h"
+#include "aoba/parser/public/parser_context.h"
+#include "aoba/parser/public/parser_context_builder.h"
+#include "aoba/parser/utils/character_reader.h"
+#include "aoba/parser/utils/lexer_utils.h"
+
+namespace aoba {
+namespace parser {
+
+namespace {
+
+const char* const kStatementKeywords[] = {
+    "class", "const",  "do",    "for", "function", "if",    "let",
+    "return", "switch", "throw", "try", "var",      "while",
+};
+
+bool IsStatementKeyword(const SourceCode& source_code, int start, int end) {
+  for (const auto* keyword : kStatementKeywords) {
+    if (static_cast<size_t>(end - start) != ::strlen(keyword))
+      continue;
+    auto offset = start;
+    while (offset < end &&
+           source_code.CharAt(offset) == keyword[offset - start]) {
+      ++offset;
+    }
+    if (offset == end)
+      return true;
+  }
+  return false;
+}
+
+// Returns offset of the first line terminator followed by a statement
+// keyword at or after |offset| in |range|, or end of |range| if not found.
+int FindChunkStart(const SourceCodeRange& range, int offset) {
+  CharacterReader reader(range.source_code().Slice(offset, range.end()));
+  while (reader.CanPeekChar()) {
+    const auto line_end = reader.FindLineTerminator();
+    if (line_end == range.end())
+      break;
+    reader.MoveTo(line_end + 1);
+    const auto word_start = reader.location();
+    reader.ConsumeWhile(IsIdentifierPart);
+    if (IsStatementKeyword(range.source_code(), word_start, reader.location()))
+      return line_end;
+  }
+  return range.end();
+}
+
+}  // namespace
+
+//
+// ParallelLexer::Error
+//
+struct ParallelLexer::Error {
+  Error(size_t index, const SourceCodeRange& range, int error_code)
+      : index(index), range(range), error_code(error_code) {}
+
+  size_t index;
+  SourceCodeRange range;
+  int error_code;
+};
+
+//
+// ParallelLexer::Chunk
+// Lexes tokens starting before |end| on a worker thread. Each chunk has its
+// own zone and node factory, since they aren't thread safe. |Chunk| is also
+// error sink of chunk lexer to associate errors to tokens.
+//
+class ParallelLexer::Chunk final : public base::DelegateSimpleThread::Delegate,
+                                   public ErrorSink {
+ public:
+  Chunk(const SourceCodeRange& range, int end, const ParserOptions& options);
+  ~Chunk() final;
+
+  const std::vector<Error>& errors() const { return errors_; }
+  const std::vector<int>& scan_starts() const { return scan_starts_; }
+  const TokenBuffer& tokens() const { return lexer_->tokens(); }
+  const std::vector<std::pair<size_t, double>>& values() const {
+    return values_;
+  }
+
+  void Join() { thread_.Join(); }
+  void Start() { thread_.Start(); }
+
+  // base::DelegateSimpleThread::Delegate
+  void Run() final;
+
+ private:
+  // ErrorSink
+  void AddError(const SourceCodeRange& range, int error_code) final;
+
+  const int end_;
+  std::vector<Error> errors_;
+  const ParserOptions& options_;
+  const SourceCodeRange range_;
+  std::vector<int> scan_starts_;
+  std::vector<std::pair<size_t, double>> values_;
+  Zone zone_;
+  ast::NodeFactory node_factory_;
+  const std::unique_ptr<ParserContext> context_;
+  std::unique_ptr<Lexer> lexer_;
+  base::DelegateSimpleThread thread_;
+
+  DISALLOW_COPY_AND_ASSIGN(Chunk);
+};
+
+ParallelLexer::Chunk::Chunk(const SourceCodeRange& range,
+                            int end,
+                            const ParserOptions& options)
+    : end_(end),
+      options_(options),
+      range_(range),
+      zone_("ParallelLexer",
+            Zone::Backing::Heap,
+            Zone::Registration::Unregistered),
+      node_factory_(&zone_),
+      context_(ParserContext::Builder()
+                   .set_error_sink(this)
+                   .set_node_factory(&node_factory_)
+                   .Build()),
+      thread_(this, "ParallelLexer") {}
+
+ParallelLexer::Chunk::~Chunk() = default;
+
+void ParallelLexer::Chunk::AddError(const SourceCodeRange& range,
+                                    int error_code) {
+  // Errors belong to token being scanned.
+  errors_.emplace_back(scan_starts_.size(), range, error_code);
+}
+
+void ParallelLexer::Chunk::Run() {
+  lexer_.reset(new Lexer(context_.get(), range_, options_, nullptr));
+  auto scan_start = range_.start();
+  while (lexer_->CanPeekToken()) {
+    const auto& tokens = lexer_->tokens();
+    const auto index = tokens.size() - 1;
+    if (tokens.start_of(index) >= end_) {
+      lexer_->tokens_.Shrink(index);
+      break;
+    }
+    if (lexer_->PeekTokenIs(ast::SyntaxCode::NumericLiteral))
+      values_.emplace_back(index, lexer_->current_value_);
+    scan_starts_.push_back(scan_start);
+    scan_start = tokens.end_of(index);
+    lexer_->SkipToken();
+  }
+}
+
+//
+// ParallelLexer
+//
+ParallelLexer::ParallelLexer(const SourceCodeRange& range,
+                             const ParserOptions& options,
+                             int number_of_threads) {
+  DCHECK_GE(number_of_threads, 1);
+  const auto chunk_size = (range.end() - range.start()) / number_of_threads;
+  std::vector<std::unique_ptr<Chunk>> chunks;
+  auto chunk_start = range.start();
+  for (auto index = 1; index < number_of_threads; ++index) {
+    const auto chunk_end = FindChunkStart(
+        range, std::max(chunk_start + 1, range.start() + chunk_size * index));
+    if (chunk_end == range.end())
+      break;
+    chunks.emplace_back(
+        new Chunk(range.source_code().Slice(chunk_start, range.end()),
+                  chunk_end, options));
+    chunk_start = chunk_end;
+  }
+  chunks.emplace_back(
+      new Chunk(range.source_code().Slice(chunk_start, range.end()),
+                range.end(), options));
+
+  // We lex the first chunk on this thread.
+  for (auto index = size_t{1}; index < chunks.size(); ++index)
+    chunks[index]->Start();
+  chunks.front()->Run();
+  for (auto index = size_t{1}; index < chunks.size(); ++index)
+    chunks[index]->Join();
+  for (const auto& chunk : chunks)
+    Merge(*chunk);
+}
+
+ParallelLexer::~ParallelLexer() = default;
+
+size_t ParallelLexer::IndexOf(int offset) {
+  if (next_index_ < scan_starts_.size() && scan_starts_[next_index_] == offset)
+    return next_index_++;
+  const auto& it =
+      std::lower_bound(scan_starts_.begin(), scan_starts_.end(), offset);
+  if (it == scan_starts_.end() || *it != offset)
+    return tokens_.size();
+  const auto index = static_cast<size_t>(it - scan_starts_.begin());
+  next_index_ = index + 1;
+  return index;
+}
+
+void ParallelLexer::Merge(const Chunk& chunk) {
+  const auto& tokens = chunk.tokens();
+  const auto base_index = tokens_.size();
+  for (auto index = size_t{0}; index < tokens.size(); ++index) {
+    tokens_.Add(tokens.syntax_of(index), tokens.kind_of(index),
+                tokens.start_of(index), tokens.end_of(index),
+                tokens.is_separated_by_newline(index));
+  }
+  scan_starts_.insert(scan_starts_.end(), chunk.scan_starts().begin(),
+                      chunk.scan_starts().end());
+  for (const auto& value : chunk.values())
+    values_.emplace_back(base_index + value.first, value.second);
+  for (const auto& error : chunk.errors()) {
+    // Errors of token after chunk end belong to next chunk.
+    if (error.index >= tokens.size())
+      break;
+    errors_.emplace_back(base_index + error.index, error.range,
+                         error.error_code);
+  }
+}
+
+void ParallelLexer::ReportErrors(size_t index, ErrorSink* error_sink) const {
+  const auto& it = std::lower_bound(
+      errors_.begin(), errors_.end(), index,
+      [](const Error& error, size_t index) { return error.index < index; });
+  for (auto runner = it; runner != errors_.end() && runner->index == index;
+       ++runner) {
+    error_sink->AddError(runner->range, runner->error_code);
+  }
+}
+
+double ParallelLexer::ValueOf(size_t index) const {
+  const auto& it = std::lower_bound(
+      values_.begin(), values_.end(), std::make_pair(index, 0.0),
+      [](const std::pair<size_t, double>& value1,
+         const std::pair<size_t, double>& value2) {
+        return value1.first < value2.first;
+      });
+  DCHECK(it != values_.end() && it->first == index) << index;
+  return it->second;
+}
+
+}  // namespace parser
+}  // namespace aoba
@@ -0,0 +1,80 @@
+// Copyright (c) 2016 Project Vogue. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef AOBA_PARSER_LEXER_PARALLEL_LEXER_H_
+#define AOBA_PARSER_LEXER_PARALLEL_LEXER_H_
+
+#include <utility>
+#include <vector>
+
+#include "base/macros.h"
+#include "aoba/base/source_code_range.h"
+#include "aoba/parser/lexer/token_buffer.h"
+
+namespace aoba {
+
+class ErrorSink;
+class ParserOptions;
+
+namespace parser {
+
+//
+// ParallelLexer
+// Splits large source code into chunks at a line terminator followed by a
+// statement keyword, and lexes chunks on worker threads. A chunk may start
+// inside a comment, a string literal or a regular expression. So |Lexer|
+// takes a prescanned token only if it starts scanning at the offset where a
+// chunk lexer started scanning the token, and scans serially otherwise.
+// Since scanning a token depends only on its start offset, tokens are same
+// as serial lexing.
+//
+class ParallelLexer final {
+ public:
+  // Source code smaller than this is lexed serially.
+  static const int kMinSourceSize = 1 << 20;
+
+  ParallelLexer(const SourceCodeRange& range,
+                const ParserOptions& options,
+                int number_of_threads);
+  ~ParallelLexer();
+
+  const TokenBuffer& tokens() const { return tokens_; }
+
+  // Returns index of token which a chunk lexer started scanning at |offset|,
+  // including whitespaces before token, or |tokens().size()| if not found.
+  size_t IndexOf(int offset);
+
+  // Reports errors found during scanning token at |index| to |error_sink|.
+  void ReportErrors(size_t index, ErrorSink* error_sink) const;
+
+  // Returns value of numeric literal token at |index|.
+  double ValueOf(size_t index) const;
+
+ private:
+  class Chunk;
+  struct Error;
+
+  void Merge(const Chunk& chunk);
+
+  // Errors ordered by token index.
+  std::vector<Error> errors_;
+
+  // Hint for |IndexOf()|, since |Lexer| asks tokens in order.
+  size_t next_index_ = 0;
+
+  // Offsets where chunk lexers started scanning tokens.
+  std::vector<int> scan_starts_;
+
+  TokenBuffer tokens_;
+
+  // Values of numeric literal tokens ordered by token index.
+  std::vector<std::pair<size_t, double>> values_;
+
+  DISALLOW_COPY_AND_ASSIGN(ParallelLexer);
+};
+
+}  // namespace parser
+}  // namespace aoba
+
+#endif  // AOBA_PARSER_LEXER_PARALLEL_LEXER_H_
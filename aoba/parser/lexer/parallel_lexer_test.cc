@@ -0,0 +1,119 @@
+// Copyright (c) 2016 Project Vogue. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <sstream>
+#include <string>
+
+#include "aoba/parser/lexer/parallel_lexer.h"
+
+#include "base/macros.h"
+#include "base/strings/string_piece.h"
+#include "aoba/ast/literals.h"
+#include "aoba/ast/node.h"
+#include "aoba/ast/tokens.h"
+#include "aoba/parser/lexer/lexer.h"
+#include "aoba/parser/public/parser_options.h"
+#include "aoba/parser/public/parser_options_builder.h"
+#include "aoba/testing/lexer_test_base.h"
+#include "aoba/testing/simple_error_sink.h"
+
+namespace aoba {
+namespace parser {
+
+//
+// ParallelLexerTest
+//
+class ParallelLexerTest : public LexerTestBase {
+ protected:
+  ParallelLexerTest() = default;
+  ~ParallelLexerTest() override = default;
+
+  // Returns tokens and errors of source code with |number_of_threads|.
+  std::string Lex(int number_of_threads);
+
+  // Prepares source code larger than |ParallelLexer::kMinSourceSize| by
+  // repeating |unit|.
+  void PrepareLargeSourceCode(base::StringPiece unit);
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(ParallelLexerTest);
+};
+
+std::string ParallelLexerTest::Lex(int number_of_threads) {
+  const auto& options = ParserOptions::Builder()
+                            .set_number_of_lexer_threads(number_of_threads)
+                            .Build();
+  const auto number_of_errors = error_sink().errors().size();
+  Lexer lexer(&context(), source_code().range(), options);
+  std::ostringstream ostream;
+  auto last_kind = ast::TokenKind::Invalid;
+  while (lexer.CanPeekToken()) {
+    // Like parser, we treat "/" after "=" as start of regular expression.
+    if (last_kind == ast::TokenKind::Equal &&
+        lexer.PeekTokenIs(ast::TokenKind::Divide)) {
+      lexer.ExtendTokenAsRegExp();
+    }
+    last_kind = lexer.PeekTokenKind();
+    ostream << (lexer.is_separated_by_newline() ? '\n' : ' ');
+    const auto& token = lexer.ConsumeToken();
+    ostream << token;
+    // Syntax factory shares syntax of numeric literals of same value.
+    if (token.Is<ast::NumericLiteral>())
+      ostream << '@' << static_cast<const void*>(&token.syntax());
+  }
+  for (auto index = number_of_errors; index < error_sink().errors().size();
+       ++index) {
+    const auto& error = *error_sink().errors()[index];
+    ostream << ' ' << error.error_code() << '@' << error.range();
+  }
+  return ostream.str();
+}
+
+void ParallelLexerTest::PrepareLargeSourceCode(base::StringPiece unit) {
+  std::string source_text;
+  const auto kMinSourceSize =
+      static_cast<size_t>(ParallelLexer::kMinSourceSize);
+  while (source_text.size() < kMinSourceSize)
+    source_text.append(unit.data(), unit.size());
+  PrepareSouceCode(source_text);
+}
+
+TEST_F(ParallelLexerTest, Basic) {
+  PrepareLargeSourceCode(
+      "function foo(a, b) {\n"
+      "  var x = a + b * 1.5e3;\n"
+      "  return x;\n"
+      "}\n");
+  const auto& range = source_code().range();
+  ParallelLexer lexer(range, ParserOptions(), 4);
+  EXPECT_EQ(0u, lexer.IndexOf(range.start()));
+  EXPECT_EQ(1u, lexer.IndexOf(lexer.tokens().end_of(0)));
+  EXPECT_EQ(lexer.tokens().size(), lexer.IndexOf(lexer.tokens().start_of(1)))
+      << "Chunk lexer started scanning second token at end of first token.";
+  EXPECT_EQ(Lex(1), Lex(4));
+}
+
+TEST_F(ParallelLexerTest, SameAsSerial) {
+  // Chunk lexers may start at "function", "var" or "if" in comment, string
+  // literal, template literal or regular expression.
+  PrepareLargeSourceCode(
+      "function foo(a) {\n"
+      "  var x = 0x10 + .5; /* block comment\n"
+      "function in comment */\n"
+      "  var s = 'string\\\n"
+      "function in string';\n"
+      "  var t = `template\n"
+      "var in template`;\n"
+      "  return a / 2 / x;\n"
+      "}\n"
+      "var r = /ab[/]\\/c/g;\n"
+      "if (r) { # }\n");
+  const auto& serial = Lex(1);
+  EXPECT_EQ(serial, Lex(2));
+  EXPECT_EQ(serial, Lex(7));
+  EXPECT_EQ(serial, Lex(64));
+}
+
+}  // namespace parser
+}  // namespace aoba
@@ -0,0 +1,79 @@
+// Copyright (c) 2016 Project Vogue. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <algorithm>
+
+#include "aoba/parser/lexer/token_buffer.h"
+
+namespace aoba {
+namespace parser {
+
+namespace {
+
+template <typename T>
+void ReplaceElements(std::vector<T>* elements,
+                     size_t start,
+                     size_t end,
+                     const std::vector<T>& new_elements) {
+  if (end - start == new_elements.size()) {
+    std::copy(new_elements.begin(), new_elements.end(),
+              elements->begin() + start);
+    return;
+  }
+  elements->erase(elements->begin() + start, elements->begin() + end);
+  elements->insert(elements->begin() + start, new_elements.begin(),
+                   new_elements.end());
+}
+
+}  // namespace
+
+//
+// TokenBuffer
+//
+TokenBuffer::TokenBuffer() = default;
+TokenBuffer::~TokenBuffer() = default;
+
+void TokenBuffer::Add(ast::SyntaxCode syntax,
+                      ast::TokenKind kind,
+                      int start,
+                      int end,
+                      bool is_separated_by_newline) {
+  DCHECK_LE(start, end);
+  flags_.push_back(is_separated_by_newline ? kSeparatedByNewline : 0);
+  kinds_.push_back(kind);
+  lengths_.push_back(static_cast<uint32_t>(end - start));
+  starts_.push_back(static_cast<uint32_t>(start));
+  syntaxes_.push_back(syntax);
+}
+
+void TokenBuffer::Replace(size_t start,
+                          size_t end,
+                          const TokenBuffer& tokens,
+                          int delta) {
+  DCHECK_LE(start, end);
+  DCHECK_LE(end, size());
+  ReplaceElements(&flags_, start, end, tokens.flags_);
+  ReplaceElements(&kinds_, start, end, tokens.kinds_);
+  ReplaceElements(&lengths_, start, end, tokens.lengths_);
+  ReplaceElements(&starts_, start, end, tokens.starts_);
+  ReplaceElements(&syntaxes_, start, end, tokens.syntaxes_);
+  if (delta == 0)
+    return;
+  for (auto it = starts_.begin() + start + tokens.size(); it != starts_.end();
+       ++it) {
+    *it += delta;
+  }
+}
+
+void TokenBuffer::Shrink(size_t size) {
+  DCHECK_LE(size, this->size());
+  flags_.resize(size);
+  kinds_.resize(size);
+  lengths_.resize(size);
+  starts_.resize(size);
+  syntaxes_.resize(size);
+}
+
+}  // namespace parser
+}  // namespace aoba
@@ -0,0 +1,107 @@
+// Copyright (c) 2016 Project Vogue. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef AOBA_PARSER_LEXER_TOKEN_BUFFER_H_
+#define AOBA_PARSER_LEXER_TOKEN_BUFFER_H_
+
+#include <stdint.h>
+
+#include <vector>
+
+#include "base/logging.h"
+#include "base/macros.h"
+#include "aoba/ast/syntax.h"
+#include "aoba/ast/tokens.h"
+
+namespace aoba {
+namespace parser {
+
+//
+// TokenBuffer
+// Holds tokens scanned by |Lexer| in struct-of-arrays form. |kind_of()| is
+// kind of punctuator or name id of name, other tokens have
+// |TokenKind::Invalid|. |Lexer| creates |ast::Node| only for tokens parser
+// takes.
+//
+class TokenBuffer final {
+ public:
+  TokenBuffer();
+  ~TokenBuffer();
+
+  bool empty() const { return syntaxes_.empty(); }
+  size_t size() const { return syntaxes_.size(); }
+
+  int end_of(size_t index) const;
+  bool is_separated_by_newline(size_t index) const;
+  ast::TokenKind kind_of(size_t index) const;
+  int start_of(size_t index) const;
+  ast::SyntaxCode syntax_of(size_t index) const;
+
+  // Returns true if token at |index| is punctuator or name of |kind|.
+  bool Is(size_t index, ast::TokenKind kind) const;
+
+  void Add(ast::SyntaxCode syntax,
+           ast::TokenKind kind,
+           int start,
+           int end,
+           bool is_separated_by_newline);
+
+  // Replaces tokens in [|start|, |end|) with |tokens| and moves tokens after
+  // |end| by |delta| characters.
+  void Replace(size_t start, size_t end, const TokenBuffer& tokens, int delta);
+
+  // Removes tokens after the first |size| tokens.
+  void Shrink(size_t size);
+
+ private:
+  enum Flag : uint8_t {
+    kSeparatedByNewline = 1 << 0,
+  };
+
+  std::vector<uint8_t> flags_;
+  std::vector<ast::TokenKind> kinds_;
+  std::vector<uint32_t> lengths_;
+  std::vector<uint32_t> starts_;
+  std::vector<ast::SyntaxCode> syntaxes_;
+
+  DISALLOW_COPY_AND_ASSIGN(TokenBuffer);
+};
+
+inline int TokenBuffer::end_of(size_t index) const {
+  DCHECK_LT(index, size());
+  return static_cast<int>(starts_[index] + lengths_[index]);
+}
+
+inline bool TokenBuffer::is_separated_by_newline(size_t index) const {
+  DCHECK_LT(index, size());
+  return (flags_[index] & kSeparatedByNewline) != 0;
+}
+
+inline ast::TokenKind TokenBuffer::kind_of(size_t index) const {
+  DCHECK_LT(index, size());
+  return kinds_[index];
+}
+
+inline int TokenBuffer::start_of(size_t index) const {
+  DCHECK_LT(index, size());
+  return static_cast<int>(starts_[index]);
+}
+
+inline ast::SyntaxCode TokenBuffer::syntax_of(size_t index) const {
+  DCHECK_LT(index, size());
+  return syntaxes_[index];
+}
+
+inline bool TokenBuffer::Is(size_t index, ast::TokenKind kind) const {
+  DCHECK_LT(index, size());
+  if (kinds_[index] != kind)
+    return false;
+  return syntaxes_[index] == ast::SyntaxCode::Name ||
+         syntaxes_[index] == ast::SyntaxCode::Punctuator;
+}
+
+}  // namespace parser
+}  // namespace aoba
+
+#endif  // AOBA_PARSER_LEXER_TOKEN_BUFFER_H_
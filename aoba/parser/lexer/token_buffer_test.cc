@@ -0,0 +1,54 @@
+// Copyright (c) 2016 Project Vogue. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "aoba/parser/lexer/token_buffer.h"
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace aoba {
+namespace parser {
+
+TEST(TokenBufferTest, Add) {
+  TokenBuffer tokens;
+  EXPECT_TRUE(tokens.empty());
+  tokens.Add(ast::SyntaxCode::Name, ast::TokenKind::If, 0, 2, false);
+  tokens.Add(ast::SyntaxCode::Punctuator, ast::TokenKind::LeftParenthesis, 3,
+             4, true);
+  tokens.Add(ast::SyntaxCode::Comment, ast::TokenKind::Invalid, 4, 10, false);
+  EXPECT_EQ(3u, tokens.size());
+
+  EXPECT_EQ(ast::SyntaxCode::Name, tokens.syntax_of(0));
+  EXPECT_EQ(ast::TokenKind::If, tokens.kind_of(0));
+  EXPECT_EQ(0, tokens.start_of(0));
+  EXPECT_EQ(2, tokens.end_of(0));
+  EXPECT_FALSE(tokens.is_separated_by_newline(0));
+  EXPECT_TRUE(tokens.is_separated_by_newline(1));
+  EXPECT_EQ(10, tokens.end_of(2));
+}
+
+TEST(TokenBufferTest, Is) {
+  TokenBuffer tokens;
+  tokens.Add(ast::SyntaxCode::Name, ast::TokenKind::If, 0, 2, false);
+  tokens.Add(ast::SyntaxCode::Punctuator, ast::TokenKind::Comma, 2, 3, false);
+  tokens.Add(ast::SyntaxCode::Comment, ast::TokenKind::Invalid, 3, 5, false);
+  EXPECT_TRUE(tokens.Is(0, ast::TokenKind::If));
+  EXPECT_FALSE(tokens.Is(0, ast::TokenKind::Comma));
+  EXPECT_TRUE(tokens.Is(1, ast::TokenKind::Comma));
+  EXPECT_FALSE(tokens.Is(2, ast::TokenKind::Invalid))
+      << "Only names and punctuators have kind.";
+}
+
+TEST(TokenBufferTest, Shrink) {
+  TokenBuffer tokens;
+  tokens.Add(ast::SyntaxCode::Name, ast::TokenKind::If, 0, 2, false);
+  tokens.Add(ast::SyntaxCode::Punctuator, ast::TokenKind::Comma, 2, 3, false);
+  tokens.Shrink(1);
+  EXPECT_EQ(1u, tokens.size());
+  EXPECT_EQ(2, tokens.end_of(0));
+  tokens.Shrink(0);
+  EXPECT_TRUE(tokens.empty());
+}
+
+}  // namespace parser
+}  // namespace aoba
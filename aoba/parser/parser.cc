@@ -2,7 +2,6 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
-#include <iterator>
 #include <utility>
 #include <vector>
 
@@ -11,6 +10,7 @@
 #include "aoba/ast/compilation_units.h"
 #include "aoba/ast/jsdoc_syntaxes.h"
 #include "aoba/ast/node_factory.h"
+#include "aoba/ast/node_list_builder.h"
 #include "aoba/ast/node_traversal.h"
 #include "aoba/ast/statements.h"
 #include "aoba/ast/syntax.h"
@@ -27,12 +27,6 @@ namespace parser {
 
 namespace {
 
-bool IsCloseBracket(const ast::Node& token) {
-  return token == ast::TokenKind::RightBrace ||
-         token == ast::TokenKind::RightBracket ||
-         token == ast::TokenKind::RightParenthesis;
-}
-
 // Returns true if |document| contains |@fileoviewview| tag.
 bool HasJsDocTag(ast::TokenKind tag_id, const ast::Node& document) {
   for (const auto& element : ast::NodeTraversal::ChildNodesOf(document)) {
@@ -72,7 +66,7 @@ std::unique_ptr<BracketTracker> NewBracketTracker(
 Parser::NodeRangeScope::NodeRangeScope(Parser* parser)
     : offset_holder_(&parser->node_start_,
                      parser->CanPeekToken()
-                         ? parser->PeekToken().range().start()
+                         ? parser->PeekTokenRange().start()
                          : parser->source_code().end().end()) {}
 
 Parser::NodeRangeScope::~NodeRangeScope() = default;
@@ -98,8 +92,12 @@ const SourceCode& Parser::source_code() const {
   return lexer_->source_code();
 }
 
+SourceCodeRange Parser::RangeOf(const ast::Node& node) const {
+  return node.location().ToRange(source_code());
+}
+
 void Parser::AddError(const ast::Node& token, ErrorCode error_code) {
-  AddError(token.range(), error_code);
+  AddError(RangeOf(token), error_code);
 }
 
 void Parser::AddError(const SourceCodeRange& range, ErrorCode error_code) {
@@ -110,19 +108,25 @@ void Parser::AddError(const SourceCodeRange& range, ErrorCode error_code) {
 
 void Parser::AddError(ErrorCode error_code) {
   if (CanPeekToken())
-    return AddError(PeekToken(), error_code);
+    return AddError(PeekTokenRange(), error_code);
   AddError(source_code().end(), error_code);
 }
 
 void Parser::Advance() {
   if (!token_stack_.empty()) {
+    last_token_end_ = RangeOf(*token_stack_.top()).end();
     token_stack_.pop();
     return;
   }
   is_separated_by_newline_ = false;
   if (!lexer_->CanPeekToken())
     return;
-  lexer_->ConsumeToken();
+  last_token_end_ = lexer_->PeekTokenRange().end();
+  if (lexer_->PeekTokenIs(ast::SyntaxCode::JsDocDocument)) {
+    // Parse skipped JsDoc document to report its errors.
+    lexer_->PeekToken();
+  }
+  lexer_->SkipToken();
   SkipCommentTokens();
 }
 
@@ -135,35 +139,35 @@ bool Parser::CanPeekToken() const {
 const ast::Node& Parser::ConsumeToken() {
   auto& token = PeekToken();
   Advance();
-  last_token_ = &token;
   return token;
 }
 
 bool Parser::ConsumeTokenIf(ast::TokenKind kind) {
   if (!CanPeekToken())
     return false;
-  if (PeekToken() != kind)
+  if (!PeekTokenIs(kind))
     return false;
-  ConsumeToken();
+  Advance();
   return true;
 }
 
 bool Parser::ConsumeTokenIf(ast::SyntaxCode syntax) {
   if (!CanPeekToken())
     return false;
-  if (PeekToken() != syntax)
+  if (!PeekTokenIs(syntax))
     return false;
-  ConsumeToken();
+  Advance();
   return true;
 }
 
 void Parser::ExpectPunctuator(ast::TokenKind kind, ErrorCode error_code) {
   if (ConsumeTokenIf(kind))
     return;
+  const auto& tokens = lexer_->tokens();
   if (!CanPeekToken()) {
     // Unfinished statement or expression, e.g. just "foo" in source code.
     return AddError(
-        source_code().Slice(node_start_, tokens_.back()->range().end()),
+        source_code().Slice(node_start_, tokens.end_of(tokens.size() - 1)),
         error_code);
   }
   // We use previous token instead of current token, since current token may
@@ -173,8 +177,7 @@ void Parser::ExpectPunctuator(ast::TokenKind kind, ErrorCode error_code) {
   //    ~~~~~
   // }
   return AddError(
-      source_code().Slice(node_start_,
-                          (*std::next(tokens_.rbegin()))->range().end()),
+      source_code().Slice(node_start_, tokens.end_of(tokens.size() - 2)),
       error_code);
 }
 
@@ -184,7 +187,7 @@ void Parser::ExpectSemicolon() {
       return;
     if (ConsumeTokenIf(ast::TokenKind::Semicolon))
       return;
-    if (PeekToken() == ast::TokenKind::RightBrace)
+    if (PeekTokenIs(ast::TokenKind::RightBrace))
       return;
     if (is_separated_by_newline_)
       return;
@@ -198,7 +201,14 @@ void Parser::Finish() {
 }
 
 SourceCodeRange Parser::GetSourceCodeRange() const {
-  return source_code().Slice(node_start_, last_token_->range().end());
+  DCHECK_GE(last_token_end_, 0);
+  return source_code().Slice(node_start_, last_token_end_);
+}
+
+Parser::Checkpoint Parser::NewCheckpoint() const {
+  DCHECK(token_stack_.empty());
+  return Checkpoint{bracket_tracker_->depth(),
+                    node_factory().CreateCheckpoint()};
 }
 
 const ast::Node& Parser::NewEmptyName() {
@@ -211,25 +221,62 @@ const ast::Node& Parser::PeekToken() const {
   return *token_stack_.top();
 }
 
+bool Parser::PeekTokenIs(ast::TokenKind kind) const {
+  if (token_stack_.empty())
+    return lexer_->PeekTokenIs(kind);
+  return *token_stack_.top() == kind;
+}
+
+bool Parser::PeekTokenIs(ast::SyntaxCode syntax) const {
+  if (token_stack_.empty())
+    return lexer_->PeekTokenIs(syntax);
+  return *token_stack_.top() == syntax;
+}
+
+ast::TokenKind Parser::PeekTokenKind() const {
+  if (token_stack_.empty())
+    return lexer_->PeekTokenKind();
+  return ast::Token::KindOf(*token_stack_.top());
+}
+
+SourceCodeRange Parser::PeekTokenRange() const {
+  if (token_stack_.empty())
+    return lexer_->PeekTokenRange();
+  return RangeOf(*token_stack_.top());
+}
+
 void Parser::PushBackToken(const ast::Node& token) {
   token_stack_.push(&token);
 }
 
+const ast::Node& Parser::RewindKeeping(const Checkpoint& checkpoint,
+                                       const ast::Node& node) {
+  // Open brackets after |checkpoint| should be closed, since
+  // |BracketTracker| holds open bracket tokens.
+  if (!token_stack_.empty() || !lexer_->CanPeekToken() ||
+      bracket_tracker_->depth() >= checkpoint.bracket_depth) {
+    return node;
+  }
+  auto& new_node =
+      node_factory().RewindKeeping(checkpoint.zone_checkpoint, node);
+  lexer_->ResetTokenNode();
+  return new_node;
+}
+
 const ast::Node& Parser::Run() {
-  std::vector<const ast::Node*> statements;
+  ast::NodeListBuilder statements(&node_factory());
   SkipCommentTokens();
   while (CanPeekToken()) {
-    const auto& token = PeekToken();
-    if (token != ast::SyntaxCode::JsDocDocument) {
+    if (!PeekTokenIs(ast::SyntaxCode::JsDocDocument)) {
       statements.push_back(&ParseStatement());
       continue;
     }
 
-    if (HasJsDocTag(ast::TokenKind::AtFileOverview, token)) {
+    if (HasJsDocTag(ast::TokenKind::AtFileOverview, PeekToken())) {
       const auto& document = ConsumeToken();
       if (file_overview_) {
         AddError(
-            SourceCodeRange::Merge(file_overview_->range(), document.range()),
+            SourceCodeRange::Merge(RangeOf(*file_overview_), RangeOf(document)),
             ErrorCode::ERROR_JSDOC_MULTIPLE_FILE_OVERVIEWS);
       }
       file_overview_ = &document;
@@ -243,20 +290,22 @@ const ast::Node& Parser::Run() {
   Finish();
   if (file_overview_ &&
       HasJsDocTag(ast::TokenKind::AtExterns, *file_overview_)) {
-    return node_factory().NewExterns(source_code().range(), statements);
+    return node_factory().NewExterns(source_code().range(), &statements);
   }
-  return node_factory().NewModule(source_code().range(), statements);
+  return node_factory().NewModule(source_code().range(), &statements);
 }
 
 void Parser::SkipCommentTokens() {
   while (lexer_->CanPeekToken()) {
     if (lexer_->is_separated_by_newline())
       is_separated_by_newline_ = true;
-    bracket_tracker_->Feed(PeekToken());
-    tokens_.push_back(&PeekToken());
-    if (PeekToken() != ast::SyntaxCode::Comment)
+    if (lexer_->PeekTokenIs(ast::SyntaxCode::Punctuator)) {
+      bracket_tracker_->Feed(lexer_->PeekTokenKind(),
+                             lexer_->PeekTokenRange());
+    }
+    if (!lexer_->PeekTokenIs(ast::SyntaxCode::Comment))
       return;
-    lexer_->ConsumeToken();
+    lexer_->SkipToken();
   }
 }
 
@@ -265,13 +314,17 @@ bool Parser::SkipToListElement() {
   DCHECK_GT(current_depth, 0u) << "We should call SkipListElement() in list.";
   while (CanPeekToken()) {
     if (current_depth != bracket_tracker_->depth()) {
-      ConsumeToken();
+      Advance();
       continue;
     }
-    if (IsCloseBracket(PeekToken()))
+    if (PeekTokenIs(ast::TokenKind::RightBrace) ||
+        PeekTokenIs(ast::TokenKind::RightBracket) ||
+        PeekTokenIs(ast::TokenKind::RightParenthesis)) {
       return false;
-    if (ConsumeToken() == ast::TokenKind::Comma)
+    }
+    if (ConsumeTokenIf(ast::TokenKind::Comma))
       return true;
+    Advance();
   }
   return false;
 }
@@ -13,6 +13,7 @@
 #include "base/auto_reset.h"
 #include "base/macros.h"
 #include "aoba/ast/syntax_forward.h"
+#include "aoba/base/memory/zone.h"
 #include "aoba/base/source_code_range.h"
 #include "aoba/parser/public/parse.h"
 
@@ -21,6 +22,10 @@ namespace aoba {
 class SourceCode;
 class SourceCodeRange;
 
+namespace ast {
+class NodeListBuilder;
+}
+
 namespace parser {
 
 class BracketTracker;
@@ -49,6 +54,13 @@ class Parser final {
  private:
   friend class ParserTest;
 
+  // Parser state for releasing nodes created by abandoned cover grammar
+  // parsing. |NewCheckpoint()| creates checkpoint.
+  struct Checkpoint {
+    size_t bracket_depth;
+    Zone::Checkpoint zone_checkpoint;
+  };
+
   // Help class for tracking node start offset.
   class NodeRangeScope final {
    public:
@@ -64,10 +76,15 @@ class Parser final {
   ast::NodeFactory& node_factory() const;
   const SourceCode& source_code() const;
 
+  // Returns range of |node| in |source_code()|. This is faster than
+  // |ast::Node::range()|, which looks up source code of |node|.
+  SourceCodeRange RangeOf(const ast::Node& node) const;
+
   void AddError(const ast::Node& token, ErrorCode error_code);
   void AddError(const SourceCodeRange& range, ErrorCode error_code);
   void AddError(ErrorCode error_code);
 
+  // Advances to next token without creating |ast::Node| of current token.
   void Advance();
 
   bool CanPeekToken() const;
@@ -88,13 +105,30 @@ class Parser final {
   void Finish();
 
   SourceCodeRange GetSourceCodeRange() const;
+  Checkpoint NewCheckpoint() const;
   const ast::Node& PeekToken() const;
 
+  // Returns true if current token is punctuator or name of |kind|.
+  bool PeekTokenIs(ast::TokenKind kind) const;
+  bool PeekTokenIs(ast::SyntaxCode syntax) const;
+
+  // Returns kind of current punctuator, or name id of current name.
+  ast::TokenKind PeekTokenKind() const;
+  SourceCodeRange PeekTokenRange() const;
+
   // Push |token| to stack for look-ahead for
   //  - async (?=function) to async-function or name "async"
   //  - name (?=:) to label or expression statement
   void PushBackToken(const ast::Node& token);
 
+  // Releases nodes created after |checkpoint| except for |node| and current
+  // token, and returns copy of |node|. Returns |node| itself if nodes created
+  // after |checkpoint| may be referenced, e.g. in bracket tracker. Caller
+  // should consume current token after this call. Nothing but |node| tree,
+  // e.g. JsDoc documents, may keep nodes allocated after |checkpoint|.
+  const ast::Node& RewindKeeping(const Checkpoint& checkpoint,
+                                 const ast::Node& node);
+
   void SkipCommentTokens();
 
   // Returns true if we stop before list element.
@@ -115,7 +149,8 @@ class Parser final {
   const ast::Node& ParsePropertyName();
 
   // Expressions
-  OperatorPrecedence CategoryOf(const ast::Node& token) const;
+  // Returns operator precedence of current token.
+  OperatorPrecedence CategoryOfPeekToken() const;
 
   const ast::Node& ConvertExpressionToBindingElement(
       const ast::Node& expression,
@@ -128,7 +163,6 @@ class Parser final {
   const ast::Node& HandleMember(const ast::Node& expression);
   const ast::Node& HandleNewExpression(const ast::Node& expression);
 
-  OperatorPrecedence HigherPrecedenceOf(OperatorPrecedence category) const;
   const ast::Node& NewDelimiterExpression(const ast::Node& delimiter);
 
   // Returns a new |ast::ElisionExpression| after |node|.
@@ -155,12 +189,11 @@ class Parser final {
   const ast::Node& ParseRegExp();
 
   const ast::Node& ParseJsDocAsExpression();
-  std::vector<const ast::Node*> ParseArgumentList();
+  void ParseArgumentList(ast::NodeListBuilder* arguments);
   const ast::Node& ParseArrayInitializer();
   const ast::Node& ParseAssignmentExpression();
-  const ast::Node& ParseBinaryExpression(OperatorPrecedence category);
+  const ast::Node& ParseBinaryExpression();
   const ast::Node& ParseCommaExpression();
-  const ast::Node& ParseConditionalExpression();
   const ast::Node& ParseLeftHandSideExpression();
   const ast::Node& ParseNameAsExpression();
   const ast::Node& ParseNewExpression();
@@ -241,17 +274,14 @@ class Parser final {
   // line terminator.
   bool is_separated_by_newline_ = false;
 
-  // The last consumed token for specify node range.
-  const ast::Node* last_token_ = nullptr;
+  // End of the last consumed token for specify node range.
+  int last_token_end_ = -1;
   const ParserOptions& options_;
 
   // Source code offset where start of node. |NodeRangeScope| manages
   // this offset.
   int node_start_ = -1;
 
-  // List of tokens to locate comment.
-  std::vector<const ast::Node*> tokens_;
-
   // |token_stack_| is used for look ahead, e.g. detecting whether name is
   // part of an expression or label. |PushBackToken()| pushes token to this
   // stack.
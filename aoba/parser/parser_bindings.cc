@@ -36,7 +36,7 @@ std::vector<const ast::Node*> Parser::ParseBindingElements() {
       break;
     if (is_separated_by_newline_ && !options_.disable_automatic_semicolon())
       break;
-    AddError(element.range(), ErrorCode::ERROR_BINDING_EXPECT_COMMA);
+    AddError(RangeOf(element), ErrorCode::ERROR_BINDING_EXPECT_COMMA);
     continue;
   }
   return elements;
@@ -44,7 +44,7 @@ std::vector<const ast::Node*> Parser::ParseBindingElements() {
 
 const ast::Node& Parser::ParseBindingElement() {
   NodeRangeScope scope(this);
-  if (PeekToken() == ast::SyntaxCode::Name)
+  if (PeekTokenIs(ast::SyntaxCode::Name))
     return ParseNameBindingElement();
 
   if (ConsumeTokenIf(ast::TokenKind::DotDotDot)) {
@@ -59,7 +59,7 @@ const ast::Node& Parser::ParseBindingElement() {
     return ParseArrayBindingPattern();
 
   AddError(ErrorCode::ERROR_BINDING_INVALID_ELEMENT);
-  return node_factory().NewBindingInvalidElement(PeekToken().range());
+  return node_factory().NewBindingInvalidElement(PeekTokenRange());
 }
 
 // Factory helper functions
@@ -72,7 +72,7 @@ const ast::Node& Parser::NewArrayBindingPattern(
 
 const ast::Node& Parser::NewBindingCommaElement(const ast::Node& token) {
   DCHECK_EQ(token, ast::TokenKind::Comma);
-  return node_factory().NewBindingCommaElement(token.range());
+  return node_factory().NewBindingCommaElement(RangeOf(token));
 }
 
 const ast::Node& Parser::NewBindingNameElement(const ast::Node& name,
@@ -91,14 +91,14 @@ const ast::Node& Parser::NewObjectBindingPattern(
 // Paring helper functions
 const ast::Node& Parser::ParseArrayBindingPattern() {
   std::vector<const ast::Node*> elements;
-  while (CanPeekToken() && PeekToken() != ast::TokenKind::RightBracket) {
+  while (CanPeekToken() && !PeekTokenIs(ast::TokenKind::RightBracket)) {
     if (!elements.empty() &&
         *elements.back() == ast::SyntaxCode::BindingRestElement) {
-      AddError(elements.back()->range(),
+      AddError(RangeOf(*elements.back()),
                ErrorCode::ERROR_BINDING_UNEXPECT_REST);
     }
 
-    if (PeekToken() == ast::TokenKind::Comma) {
+    if (PeekTokenIs(ast::TokenKind::Comma)) {
       elements.push_back(&NewBindingCommaElement(ConsumeToken()));
       continue;
     }
@@ -135,8 +135,8 @@ const ast::Node& Parser::ParseNameBindingElement() {
 const ast::Node& Parser::ParseObjectBindingPattern() {
   std::vector<const ast::Node*> elements;
 
-  while (CanPeekToken() && PeekToken() != ast::TokenKind::RightBrace) {
-    if (PeekToken() == ast::TokenKind::Comma) {
+  while (CanPeekToken() && !PeekTokenIs(ast::TokenKind::RightBrace)) {
+    if (PeekTokenIs(ast::TokenKind::Comma)) {
       AddError(ErrorCode::ERROR_BINDING_UNEXPECT_COMMA);
       elements.push_back(&NewBindingCommaElement(ConsumeToken()));
       continue;
@@ -150,7 +150,7 @@ const ast::Node& Parser::ParseObjectBindingPattern() {
       continue;
     }
 
-    if (PeekToken() == ast::SyntaxCode::Name) {
+    if (PeekTokenIs(ast::SyntaxCode::Name)) {
       NodeRangeScope scope(this);
       const auto& name = ConsumeToken();
       if (!CanPeekToken()) {
@@ -167,8 +167,8 @@ const ast::Node& Parser::ParseObjectBindingPattern() {
         elements.push_back(&NewBindingNameElement(name, initializer));
       } else {
         elements.push_back(&node_factory().NewBindingNameElement(
-            source_code().Slice(name.range().start(),
-                                PeekToken().range().start()),
+            source_code().Slice(RangeOf(name).start(),
+                                PeekTokenRange().start()),
             name, NewElisionExpression()));
       }
     } else {
@@ -177,14 +177,14 @@ const ast::Node& Parser::ParseObjectBindingPattern() {
 
     if (!CanPeekToken())
       break;
-    if (PeekToken() == ast::TokenKind::Comma) {
+    if (PeekTokenIs(ast::TokenKind::Comma)) {
       elements.push_back(&NewBindingCommaElement(ConsumeToken()));
       continue;
     }
 
     if (!CanStartBindingElement(PeekToken()))
       continue;
-    AddError(elements.back()->range(), ErrorCode::ERROR_BINDING_EXPECT_COMMA);
+    AddError(RangeOf(*elements.back()), ErrorCode::ERROR_BINDING_EXPECT_COMMA);
   }
   ConsumeTokenIf(ast::TokenKind::RightBrace);
   if (!ConsumeTokenIf(ast::TokenKind::Equal))
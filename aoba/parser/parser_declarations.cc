@@ -17,15 +17,15 @@ const ast::Node& Parser::ParseArrowFunctionBody() {
     return NewInvalidStatement(
         ErrorCode::ERROR_FUNCTION_INVALID_ARROW_FUNCTION_BODY);
   }
-  if (PeekToken() == ast::TokenKind::LeftBrace)
+  if (PeekTokenIs(ast::TokenKind::LeftBrace))
     return ParseStatement();
   return ParseAssignmentExpression();
 }
 
 const ast::Node& Parser::ParseClass() {
   NodeRangeScope scope(this);
-  DCHECK_EQ(PeekToken(), ast::TokenKind::Class);
-  ConsumeToken();
+  DCHECK(PeekTokenIs(ast::TokenKind::Class));
+  Advance();
   auto& class_name = ParseClassName();
   auto& heritage = ParseClassHeritage();
   auto& class_body = ParseClassBody();
@@ -35,7 +35,7 @@ const ast::Node& Parser::ParseClass() {
 
 const ast::Node& Parser::ParseClassBody() {
   NodeRangeScope scope(this);
-  if (!CanPeekToken() || PeekToken() != ast::TokenKind::LeftBrace)
+  if (!CanPeekToken() || !PeekTokenIs(ast::TokenKind::LeftBrace))
     return NewInvalidExpression(ErrorCode::ERROR_CLASS_EXPECT_LBRACE);
   return ParsePrimaryExpression();
 }
@@ -47,15 +47,15 @@ const ast::Node& Parser::ParseClassHeritage() {
 }
 
 const ast::Node& Parser::ParseClassName() {
-  if (!CanPeekToken() || PeekToken() != ast::SyntaxCode::Name)
+  if (!CanPeekToken() || !PeekTokenIs(ast::SyntaxCode::Name))
     return NewEmptyName();
-  if (PeekToken() == ast::TokenKind::Extends)
+  if (PeekTokenIs(ast::TokenKind::Extends))
     return NewEmptyName();
   return ConsumeToken();
 }
 
 const ast::Node& Parser::ParseFunction(ast::FunctionKind kind) {
-  const auto& name = CanPeekToken() && PeekToken() == ast::SyntaxCode::Name
+  const auto& name = CanPeekToken() && PeekTokenIs(ast::SyntaxCode::Name)
                          ? ConsumeToken()
                          : NewEmptyName();
   const auto& parameter_list = ParseParameterList();
@@ -65,7 +65,7 @@ const ast::Node& Parser::ParseFunction(ast::FunctionKind kind) {
 }
 
 const ast::Node& Parser::ParseFunctionBody() {
-  if (!CanPeekToken() || PeekToken() != ast::TokenKind::LeftBrace)
+  if (!CanPeekToken() || !PeekTokenIs(ast::TokenKind::LeftBrace))
     return NewInvalidStatement(ErrorCode::ERROR_FUNCTION_EXPECT_LBRACE);
   NodeRangeScope scope(this);
   return ParseStatement();
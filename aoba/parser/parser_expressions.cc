@@ -2,6 +2,7 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <utility>
 #include <vector>
 
 #include "aoba/parser/parser.h"
@@ -10,6 +11,7 @@
 #include "aoba/ast/expressions.h"
 #include "aoba/ast/literals.h"
 #include "aoba/ast/node_factory.h"
+#include "aoba/ast/node_list_builder.h"
 #include "aoba/ast/node_traversal.h"
 #include "aoba/ast/regexp.h"
 #include "aoba/ast/tokens.h"
@@ -68,15 +70,14 @@ ast::FunctionKind FunctionKindOf(const ast::Node& token) {
 // Convert |++| and |--| token to a token which represent post update
 // operator.
 const ast::Node& ConvertToPostOperator(ast::NodeFactory* factory,
-                                       const ast::Node& op) {
-  if (op == ast::TokenKind::PlusPlus) {
-    return factory->NewPunctuator(op.range(), ast::TokenKind::PostPlusPlus);
-  }
-  if (op == ast::TokenKind::MinusMinus) {
-    return factory->NewPunctuator(op.range(), ast::TokenKind::PostMinusMinus);
-  }
+                                       const ast::Node& op,
+                                       const SourceCodeRange& range) {
+  if (op == ast::TokenKind::PlusPlus)
+    return factory->NewPunctuator(range, ast::TokenKind::PostPlusPlus);
+  if (op == ast::TokenKind::MinusMinus)
+    return factory->NewPunctuator(range, ast::TokenKind::PostMinusMinus);
   NOTREACHED() << op;
-  return factory->NewPunctuator(op.range(), ast::TokenKind::Invalid);
+  return factory->NewPunctuator(range, ast::TokenKind::Invalid);
 }
 
 bool IsKeywordOperator(const ast::Node& token) {
@@ -100,9 +101,35 @@ bool IsUpdateOperator(const ast::Node& token) {
          token == ast::TokenKind::MinusMinus;
 }
 
+// Left operand and operator waiting for right operand in
+// |Parser::ParseBinaryExpression()|.
+struct PendingBinaryExpression {
+  const ast::Node* left;
+  const ast::Node* op;
+  Parser::OperatorPrecedence category;
+  int start;
+};
+
+// Assignment or conditional expression waiting for right most operand in
+// |Parser::ParseAssignmentExpression()|.
+struct PendingAssignmentExpression {
+  enum class State {
+    Assignment,
+    Condition,
+    TrueExpression,
+  };
+
+  State state;
+  // Left hand side or condition.
+  const ast::Node* first;
+  // Operator or true expression.
+  const ast::Node* second;
+  int start;
+};
+
 }  // namespace
 
-Parser::OperatorPrecedence Parser::CategoryOf(const ast::Node& token) const {
+Parser::OperatorPrecedence Parser::CategoryOfPeekToken() const {
   static const OperatorPrecedence CategoryMap[] = {
 #define V(string, capital, upper, category) \
   Parser::OperatorPrecedence::category,
@@ -110,14 +137,16 @@ Parser::OperatorPrecedence Parser::CategoryOf(const ast::Node& token) const {
 #undef V
   };
 
-  if (token == ast::TokenKind::InstanceOf || token == ast::TokenKind::In)
+  if (PeekTokenIs(ast::TokenKind::InstanceOf) ||
+      PeekTokenIs(ast::TokenKind::In)) {
     return Parser::OperatorPrecedence::Relational;
-  if (token != ast::SyntaxCode::Punctuator)
+  }
+  if (!PeekTokenIs(ast::SyntaxCode::Punctuator))
     return Parser::OperatorPrecedence::None;
-  const auto kind = ast::Punctuator::KindOf(token);
+  const auto kind = PeekTokenKind();
   const auto* it = std::begin(CategoryMap) + static_cast<size_t>(kind);
-  DCHECK(it >= std::begin(CategoryMap)) << token;
-  DCHECK(it < std::end(CategoryMap)) << token;
+  DCHECK(it >= std::begin(CategoryMap)) << PeekTokenRange();
+  DCHECK(it < std::end(CategoryMap)) << PeekTokenRange();
   return *it;
 }
 
@@ -126,7 +155,7 @@ const ast::Node& Parser::ConvertExpressionToBindingElement(
     const ast::Node* initializer) {
   if (expression == ast::SyntaxCode::ReferenceExpression) {
     return node_factory().NewBindingNameElement(
-        expression.range(), ast::ReferenceExpression::NameOf(expression),
+        RangeOf(expression), ast::ReferenceExpression::NameOf(expression),
         initializer ? *initializer : NewElisionExpression(expression));
   }
   if (expression == ast::SyntaxCode::ArrayInitializer) {
@@ -134,7 +163,7 @@ const ast::Node& Parser::ConvertExpressionToBindingElement(
     for (const auto& element : ast::NodeTraversal::ChildNodesOf(expression))
       elements.push_back(&ConvertExpressionToBindingElement(element, nullptr));
     return node_factory().NewArrayBindingPattern(
-        expression.range(), elements,
+        RangeOf(expression), elements,
         initializer ? *initializer : NewElisionExpression(expression));
   }
   if (expression == ast::SyntaxCode::ObjectInitializer) {
@@ -142,14 +171,14 @@ const ast::Node& Parser::ConvertExpressionToBindingElement(
     for (const auto& member : ast::NodeTraversal::ChildNodesOf(expression))
       members.push_back(&ConvertExpressionToBindingElement(member, nullptr));
     return node_factory().NewObjectBindingPattern(
-        expression.range(), members,
+        RangeOf(expression), members,
         initializer ? *initializer : NewElisionExpression(expression));
   }
   if (expression == ast::SyntaxCode::Property) {
     const auto& property_name = ast::Property::NameOf(expression);
     if (property_name == ast::SyntaxCode::ReferenceExpression) {
       return node_factory().NewBindingProperty(
-          expression.range(), ast::ReferenceExpression::NameOf(property_name),
+          RangeOf(expression), ast::ReferenceExpression::NameOf(property_name),
           ConvertExpressionToBindingElement(ast::Property::ValueOf(expression),
                                             nullptr));
     }
@@ -161,7 +190,7 @@ const ast::Node& Parser::ConvertExpressionToBindingElement(
           &ast::AssignmentExpression::RightHandSideOf(expression));
     }
   }
-  return node_factory().NewBindingInvalidElement(expression.range());
+  return node_factory().NewBindingInvalidElement(RangeOf(expression));
 }
 
 std::vector<const ast::Node*> Parser::ConvertExpressionToBindingElements(
@@ -183,7 +212,7 @@ const ast::Node& Parser::HandleComputedMember(const ast::Node& expression) {
 }
 
 const ast::Node& Parser::HandleMember(const ast::Node& expression) {
-  if (!CanPeekToken() || PeekToken() != ast::SyntaxCode::Name) {
+  if (!CanPeekToken() || !PeekTokenIs(ast::SyntaxCode::Name)) {
     AddError(ErrorCode::ERROR_EXPRESSION_EXPECT_NAME);
     return expression;
   }
@@ -210,24 +239,19 @@ const ast::Node& Parser::HandleNewExpression(
   return *expression;
 }
 
-Parser::OperatorPrecedence Parser::HigherPrecedenceOf(
-    OperatorPrecedence category) const {
-  DCHECK_NE(category, OperatorPrecedence::None);
-  return static_cast<OperatorPrecedence>(static_cast<int>(category) + 1);
-}
-
 const ast::Node& Parser::NewDelimiterExpression(const ast::Node& delimiter) {
-  return node_factory().NewDelimiterExpression(delimiter.range());
+  return node_factory().NewDelimiterExpression(RangeOf(delimiter));
 }
 
 const ast::Node& Parser::NewElisionExpression(const ast::Node& node) {
   return node_factory().NewElisionExpression(
-      SourceCodeRange::CollapseToEnd(node.range()));
+      SourceCodeRange::CollapseToEnd(RangeOf(node)));
 }
 
 const ast::Node& Parser::NewElisionExpression() {
-  DCHECK(last_token_);
-  return NewElisionExpression(*last_token_);
+  DCHECK_GE(last_token_end_, 0);
+  return node_factory().NewElisionExpression(
+      source_code().Slice(last_token_end_, last_token_end_));
 }
 
 const ast::Node& Parser::NewInvalidExpression(const SourceCodeRange& range,
@@ -238,7 +262,7 @@ const ast::Node& Parser::NewInvalidExpression(const SourceCodeRange& range,
 
 const ast::Node& Parser::NewInvalidExpression(const ast::Node& token,
                                               ErrorCode error_code) {
-  return NewInvalidExpression(token.range(), error_code);
+  return NewInvalidExpression(RangeOf(token), error_code);
 }
 
 const ast::Node& Parser::NewInvalidExpression(ErrorCode error_code) {
@@ -263,35 +287,34 @@ const ast::Node& Parser::ParseJsDocAsExpression() {
 }
 
 // Parse argument list after consuming left parenthesis.
-std::vector<const ast::Node*> Parser::ParseArgumentList() {
+void Parser::ParseArgumentList(ast::NodeListBuilder* arguments) {
   if (ConsumeTokenIf(ast::TokenKind::RightParenthesis))
-    return {};
-  std::vector<const ast::Node*> arguments;
+    return;
   while (CanPeekToken()) {
-    arguments.push_back(&ParseExpression());
+    arguments->push_back(&ParseExpression());
     if (!CanPeekToken())
       break;
     if (ConsumeTokenIf(ast::TokenKind::RightParenthesis))
-      return arguments;
-    if (PeekToken() == ast::TokenKind::Semicolon) {
+      return;
+    if (PeekTokenIs(ast::TokenKind::Semicolon)) {
       AddError(ErrorCode::ERROR_EXPRESSION_ARGUMENT_LIST_EXPECT_RPAREN);
-      return arguments;
+      return;
     }
     if (!ConsumeTokenIf(ast::TokenKind::Comma))
       AddError(ErrorCode::ERROR_EXPRESSION_ARGUMENT_LIST_EXPECT_COMMA);
   }
-  return arguments;
 }
 
 const ast::Node& Parser::ParseArrayInitializer() {
   NodeRangeScope scope(this);
-  DCHECK_EQ(PeekToken(), ast::TokenKind::LeftBracket);
-  ConsumeToken();
-  std::vector<const ast::Node*> elements;
+  DCHECK(PeekTokenIs(ast::TokenKind::LeftBracket));
+  Advance();
+  ast::NodeListBuilder elements(&node_factory());
   auto has_expression = false;
   while (CanPeekToken()) {
     if (ConsumeTokenIf(ast::TokenKind::RightBracket)) {
-      return node_factory().NewArrayInitializer(GetSourceCodeRange(), elements);
+      return node_factory().NewArrayInitializer(GetSourceCodeRange(),
+                                                &elements);
     }
     if (ConsumeTokenIf(ast::TokenKind::Comma)) {
       if (!has_expression)
@@ -302,71 +325,114 @@ const ast::Node& Parser::ParseArrayInitializer() {
     has_expression = true;
     elements.push_back(&ParseAssignmentExpression());
   }
-  return node_factory().NewArrayInitializer(GetSourceCodeRange(), elements);
+  return node_factory().NewArrayInitializer(GetSourceCodeRange(), &elements);
 }
 
 // Yet another entry pointer used for parsing computed property name.
+// Right associative assignment and conditional expressions are parsed with
+// explicit stack of pending expressions instead of recursion for long chain
+// of them in generated code.
 const ast::Node& Parser::ParseAssignmentExpression() {
-  if (!CanPeekToken())
-    return NewInvalidExpression(ErrorCode::ERROR_EXPRESSION_INVALID);
+  using State = PendingAssignmentExpression::State;
   NodeRangeScope scope(this);
-  auto& left_hand_side = ParseConditionalExpression();
-  if (!CanPeekToken() || PeekToken() != ast::SyntaxCode::Punctuator)
-    return left_hand_side;
-  if (CategoryOf(PeekToken()) != OperatorPrecedence::Assignment)
-    return left_hand_side;
-  const auto& op = ConsumeToken();
-  auto& right_hand_side = ParseAssignmentExpression();
-  return node_factory().NewAssignmentExpression(
-      GetSourceCodeRange(), op, left_hand_side, right_hand_side);
-}
-
-const ast::Node& Parser::ParseBinaryExpression(OperatorPrecedence category) {
-  NodeRangeScope scope(this);
-  if (category == OperatorPrecedence::None)
-    return ParseUnaryExpression();
-  const auto lower_category = HigherPrecedenceOf(category);
-  auto* left = &ParseBinaryExpression(lower_category);
-  while (CanPeekToken() && CategoryOf(PeekToken()) == category) {
-    auto& op = ConsumeToken();
+  std::vector<PendingAssignmentExpression> pendings;
+  for (;;) {
+    const ast::Node* expression = nullptr;
     if (!CanPeekToken()) {
-      AddError(ErrorCode::ERROR_EXPRESSION_EXPECT_EXPRESSION);
-      return *left;
-    }
-    auto& right = ParseBinaryExpression(lower_category);
-    if (op == ast::SyntaxCode::Punctuator) {
-      left = &node_factory().NewBinaryExpression(GetSourceCodeRange(), op,
-                                                 *left, right);
+      expression = &NewInvalidExpression(ErrorCode::ERROR_EXPRESSION_INVALID);
     } else {
-      left = &node_factory().NewBinaryExpression(GetSourceCodeRange(), op,
-                                                 *left, right);
+      const auto start = PeekTokenRange().start();
+      auto& left_hand_side = ParseBinaryExpression();
+      if (ConsumeTokenIf(ast::TokenKind::Question)) {
+        pendings.push_back({State::Condition, &left_hand_side, nullptr, start});
+        continue;
+      }
+      if (CanPeekToken() && PeekTokenIs(ast::SyntaxCode::Punctuator) &&
+          CategoryOfPeekToken() == OperatorPrecedence::Assignment) {
+        auto& op = ConsumeToken();
+        pendings.push_back({State::Assignment, &left_hand_side, &op, start});
+        continue;
+      }
+      expression = &left_hand_side;
+    }
+    for (;;) {
+      if (pendings.empty())
+        return *expression;
+      auto& pending = pendings.back();
+      // |NodeRangeScope| restores |node_start_|.
+      node_start_ = pending.start;
+      if (pending.state == State::Condition) {
+        ExpectPunctuator(ast::TokenKind::Colon,
+                         ErrorCode::ERROR_EXPRESSION_CONDITIONAL_EXPECT_COLON);
+        pending.state = State::TrueExpression;
+        pending.second = expression;
+        break;
+      }
+      if (pending.state == State::Assignment) {
+        expression = &node_factory().NewAssignmentExpression(
+            GetSourceCodeRange(), *pending.second, *pending.first, *expression);
+      } else {
+        expression = &node_factory().NewConditionalExpression(
+            GetSourceCodeRange(), *pending.first, *pending.second,
+            *expression);
+      }
+      pendings.pop_back();
     }
   }
-  return *left;
 }
 
-const ast::Node& Parser::ParseCommaExpression() {
+// Binary operators are parsed by precedence climbing with explicit stack of
+// pending operators instead of recursion for each precedence.
+const ast::Node& Parser::ParseBinaryExpression() {
   NodeRangeScope scope(this);
-  std::vector<const ast::Node*> expressions;
-  expressions.push_back(&ParseAssignmentExpression());
-  while (ConsumeTokenIf(ast::TokenKind::Comma))
-    expressions.push_back(&ParseAssignmentExpression());
-  if (expressions.size() == 1)
-    return *expressions.front();
-  return node_factory().NewCommaExpression(GetSourceCodeRange(), expressions);
+  std::vector<PendingBinaryExpression> pendings;
+  auto start = PeekTokenRange().start();
+  auto* right = &ParseUnaryExpression();
+  while (CanPeekToken()) {
+    const auto category = CategoryOfPeekToken();
+    if (category == OperatorPrecedence::Assignment ||
+        category == OperatorPrecedence::None) {
+      break;
+    }
+    // All binary operators are left associative.
+    while (!pendings.empty() && pendings.back().category >= category) {
+      const auto& pending = pendings.back();
+      // |NodeRangeScope| restores |node_start_|.
+      node_start_ = start = pending.start;
+      right = &node_factory().NewBinaryExpression(
+          GetSourceCodeRange(), *pending.op, *pending.left, *right);
+      pendings.pop_back();
+    }
+    auto& op = ConsumeToken();
+    if (!CanPeekToken()) {
+      AddError(ErrorCode::ERROR_EXPRESSION_EXPECT_EXPRESSION);
+      break;
+    }
+    pendings.push_back({right, &op, category, start});
+    start = PeekTokenRange().start();
+    right = &ParseUnaryExpression();
+  }
+  while (!pendings.empty()) {
+    const auto& pending = pendings.back();
+    node_start_ = pending.start;
+    right = &node_factory().NewBinaryExpression(
+        GetSourceCodeRange(), *pending.op, *pending.left, *right);
+    pendings.pop_back();
+  }
+  return *right;
 }
 
-const ast::Node& Parser::ParseConditionalExpression() {
+const ast::Node& Parser::ParseCommaExpression() {
   NodeRangeScope scope(this);
-  auto& expression = ParseBinaryExpression(OperatorPrecedence::LogicalOr);
-  if (!ConsumeTokenIf(ast::TokenKind::Question))
+  auto& expression = ParseAssignmentExpression();
+  if (!ConsumeTokenIf(ast::TokenKind::Comma))
     return expression;
-  auto& true_expression = ParseAssignmentExpression();
-  ExpectPunctuator(ast::TokenKind::Colon,
-                   ErrorCode::ERROR_EXPRESSION_CONDITIONAL_EXPECT_COLON);
-  auto& false_expression = ParseAssignmentExpression();
-  return node_factory().NewConditionalExpression(
-      GetSourceCodeRange(), expression, true_expression, false_expression);
+  ast::NodeListBuilder expressions(&node_factory());
+  expressions.push_back(&expression);
+  do {
+    expressions.push_back(&ParseAssignmentExpression());
+  } while (ConsumeTokenIf(ast::TokenKind::Comma));
+  return node_factory().NewCommaExpression(GetSourceCodeRange(), &expressions);
 }
 
 // The entry point of parsing an expression.
@@ -394,9 +460,10 @@ const ast::Node& Parser::ParseLeftHandSideExpression() {
       continue;
     }
     if (ConsumeTokenIf(ast::TokenKind::LeftParenthesis)) {
-      const auto& arguments = ParseArgumentList();
+      ast::NodeListBuilder arguments(&node_factory());
+      ParseArgumentList(&arguments);
       expression = &node_factory().NewCallExpression(GetSourceCodeRange(),
-                                                     *expression, arguments);
+                                                     *expression, &arguments);
       continue;
     }
     return *expression;
@@ -409,8 +476,8 @@ const ast::Node& Parser::ParseNameAsExpression() {
   auto& name = ConsumeToken();
   switch (ast::Token::KindOf(name)) {
     case ast::TokenKind::Async:
-      if (CanPeekToken() && PeekToken() == ast::TokenKind::Function) {
-        ConsumeToken();
+      if (CanPeekToken() && PeekTokenIs(ast::TokenKind::Function)) {
+        Advance();
         return ParseFunction(ast::FunctionKind::Async);
       }
       break;
@@ -435,7 +502,7 @@ const ast::Node& Parser::ParseNameAsExpression() {
   if (ConsumeTokenIf(ast::TokenKind::Arrow)) {
     auto& statement = ParseArrowFunctionBody();
     const auto& parameter = node_factory().NewBindingNameElement(
-        name.range(), name, NewElisionExpression());
+        RangeOf(name), name, NewElisionExpression());
     return node_factory().NewArrowFunction(
         GetSourceCodeRange(), ast::FunctionKind::Normal, parameter, statement);
   }
@@ -443,52 +510,71 @@ const ast::Node& Parser::ParseNameAsExpression() {
 }
 
 // NewExpression ::= MemberExpression | 'new' NewExpression
+// Nested 'new' are parsed with explicit stack of start offsets.
 const ast::Node& Parser::ParseNewExpression() {
   NodeRangeScope scope(this);
-  if (PeekToken() == ast::TokenKind::New) {
+  std::vector<int> starts;
+  const ast::Node* expression = nullptr;
+  while (PeekTokenIs(ast::TokenKind::New)) {
+    // |NodeRangeScope| restores |node_start_|.
+    node_start_ = PeekTokenRange().start();
     auto& name_new = ConsumeToken();
     if (!CanPeekToken()) {
-      return NewInvalidExpression(
-          ErrorCode::ERROR_EXPRESSION_EXPECT_EXPRESSION);
+      expression =
+          &NewInvalidExpression(ErrorCode::ERROR_EXPRESSION_EXPECT_EXPRESSION);
+      break;
     }
-    if (PeekToken() == ast::TokenKind::Dot)
-      return HandleNewExpression(
+    if (PeekTokenIs(ast::TokenKind::Dot)) {
+      expression = &HandleNewExpression(
           node_factory().NewReferenceExpression(name_new));
-    auto& member_expression = ParseNewExpression();
+      break;
+    }
+    starts.push_back(node_start_);
+  }
+  if (!expression) {
+    node_start_ = PeekTokenRange().start();
+    expression = &HandleNewExpression(ParsePrimaryExpression());
+  }
+  while (!starts.empty()) {
+    node_start_ = starts.back();
+    starts.pop_back();
     if (ConsumeTokenIf(ast::TokenKind::LeftParenthesis)) {
-      const auto& arguments = ParseArgumentList();
-      return node_factory().NewNewExpression(GetSourceCodeRange(),
-                                             member_expression, arguments);
+      ast::NodeListBuilder arguments(&node_factory());
+      ParseArgumentList(&arguments);
+      expression = &node_factory().NewNewExpression(GetSourceCodeRange(),
+                                                    *expression, &arguments);
+      continue;
     }
-    return HandleNewExpression(node_factory().NewNewExpression(
-        GetSourceCodeRange(), member_expression, {}));
+    ast::NodeListBuilder no_arguments(&node_factory());
+    expression = &HandleNewExpression(node_factory().NewNewExpression(
+        GetSourceCodeRange(), *expression, &no_arguments));
   }
-  return HandleNewExpression(ParsePrimaryExpression());
+  return *expression;
 }
 
 const ast::Node& Parser::ParseObjectInitializer() {
   NodeRangeScope scope(this);
-  DCHECK_EQ(PeekToken(), ast::TokenKind::LeftBrace);
-  ConsumeToken();
-  std::vector<const ast::Node*> members;
+  DCHECK(PeekTokenIs(ast::TokenKind::LeftBrace));
+  Advance();
+  ast::NodeListBuilder members(&node_factory());
   const ast::Node* annotation = nullptr;
   while (CanPeekToken()) {
     NodeRangeScope scope(this);
     if (ConsumeTokenIf(ast::TokenKind::RightBrace))
       break;
-    if (PeekToken() == ast::TokenKind::Comma) {
+    if (PeekTokenIs(ast::TokenKind::Comma)) {
       if (annotation)
         AddError(*annotation, ErrorCode::ERROR_EXPRESSION_UNEXPECT_ANNOTATION);
       members.push_back(&NewDelimiterExpression(ConsumeToken()));
       continue;
     }
-    if (PeekToken() == ast::TokenKind::Semicolon) {
+    if (PeekTokenIs(ast::TokenKind::Semicolon)) {
       if (annotation)
         AddError(*annotation, ErrorCode::ERROR_EXPRESSION_UNEXPECT_ANNOTATION);
       members.push_back(&NewDelimiterExpression(ConsumeToken()));
       continue;
     }
-    if (PeekToken() == ast::SyntaxCode::JsDocDocument) {
+    if (PeekTokenIs(ast::SyntaxCode::JsDocDocument)) {
       if (annotation)
         AddError(*annotation, ErrorCode::ERROR_EXPRESSION_UNEXPECT_ANNOTATION);
       annotation = &ConsumeToken();
@@ -505,7 +591,7 @@ const ast::Node& Parser::ParseObjectInitializer() {
       continue;
     }
 
-    if (PeekToken() == ast::TokenKind::Static) {
+    if (PeekTokenIs(ast::TokenKind::Static)) {
       // 'static' can be a property name and method name.
       auto& property_name_static = ParsePropertyName();
       if (!CanPeekToken())
@@ -548,13 +634,13 @@ const ast::Node& Parser::ParseObjectInitializer() {
   }
   if (annotation)
     AddError(*annotation, ErrorCode::ERROR_EXPRESSION_UNEXPECT_ANNOTATION);
-  return node_factory().NewObjectInitializer(GetSourceCodeRange(), members);
+  return node_factory().NewObjectInitializer(GetSourceCodeRange(), &members);
 }
 
 const ast::Node& Parser::ParseParenthesis() {
   NodeRangeScope scope(this);
-  DCHECK_EQ(PeekToken(), ast::TokenKind::LeftParenthesis);
-  ConsumeToken();
+  DCHECK(PeekTokenIs(ast::TokenKind::LeftParenthesis));
+  Advance();
   if (ConsumeTokenIf(ast::TokenKind::RightParenthesis)) {
     auto& parameter_list =
         node_factory().NewParameterList(GetSourceCodeRange(), {});
@@ -565,20 +651,24 @@ const ast::Node& Parser::ParseParenthesis() {
                                            ast::FunctionKind::Normal,
                                            parameter_list, statement);
   }
+  const auto& checkpoint = NewCheckpoint();
   auto& sub_expression = ParseExpression();
   ExpectPunctuator(ast::TokenKind::RightParenthesis,
                    ErrorCode::ERROR_EXPRESSION_PRIMARY_EXPECT_RPAREN);
-  auto& expression =
-      node_factory().NewGroupExpression(GetSourceCodeRange(), sub_expression);
-  if (!ConsumeTokenIf(ast::TokenKind::Arrow))
-    return expression;
+  if (!CanPeekToken() || !PeekTokenIs(ast::TokenKind::Arrow))
+    return node_factory().NewGroupExpression(GetSourceCodeRange(),
+                                             sub_expression);
+  // "(" Expression ")" is a cover grammar of arrow function parameters. We
+  // release nodes of |sub_expression| after converting it.
+  auto& parameter_list = RewindKeeping(
+      checkpoint, node_factory().NewParameterList(
+                      GetSourceCodeRange(),
+                      ConvertExpressionToBindingElements(sub_expression)));
+  Advance();
   auto& statement = ParseArrowFunctionBody();
-  return node_factory().NewArrowFunction(
-      GetSourceCodeRange(), ast::FunctionKind::Normal,
-      node_factory().NewParameterList(
-          expression.range(),
-          ConvertExpressionToBindingElements(sub_expression)),
-      statement);
+  return node_factory().NewArrowFunction(GetSourceCodeRange(),
+                                         ast::FunctionKind::Normal,
+                                         parameter_list, statement);
 }
 
 // The entry point for parsing property name.
@@ -622,7 +712,7 @@ const ast::Node& Parser::ParsePropertyAfterName(
     return ParseMethod(method_kind, function_kind);
   }
 
-  if (PeekToken() == ast::TokenKind::LeftParenthesis) {
+  if (PeekTokenIs(ast::TokenKind::LeftParenthesis)) {
     // PropertyName '(' ParameterList ')' '{' StatementList '}'
     auto& parameter_list = ParseParameterList();
     auto& method_body = ParseFunctionBody();
@@ -635,7 +725,7 @@ const ast::Node& Parser::ParsePropertyAfterName(
   if (method_kind == ast::MethodKind::Static)
     AddError(ErrorCode::ERROR_PROPERTY_INVALID_STATIC);
 
-  if (PeekToken() == ast::TokenKind::RightBrace)
+  if (PeekTokenIs(ast::TokenKind::RightBrace))
     return property_name;
 
   if (ConsumeTokenIf(ast::TokenKind::Comma))
@@ -647,7 +737,7 @@ const ast::Node& Parser::ParsePropertyAfterName(
                                       expression);
   }
 
-  if (PeekToken() == ast::TokenKind::Equal) {
+  if (PeekTokenIs(ast::TokenKind::Equal)) {
     auto& op = ConsumeToken();
     auto& expression = ParseAssignmentExpression();
     return node_factory().NewAssignmentExpression(GetSourceCodeRange(), op,
@@ -666,7 +756,7 @@ const ast::Node& Parser::ParsePropertyName() {
     return NewInvalidExpression(
         ErrorCode::ERROR_PROPERTY_INVALID_PROPERTY_NAME);
   }
-  if (PeekToken() == ast::SyntaxCode::Name) {
+  if (PeekTokenIs(ast::SyntaxCode::Name)) {
     // Note: we can use any name as property name including keywords.
     return ConsumeToken();
   }
@@ -679,15 +769,17 @@ const ast::Node& Parser::ParseRegExpLiteral() {
   NodeRangeScope scope(this);
   auto& source = lexer_->ExtendTokenAsRegExp();
   // Consume |RegExpSource| node.
-  ConsumeToken();
+  Advance();
+
+  const auto& source_range = RangeOf(source);
 
   // Skip starting "/"
-  const auto regexp_start = source.range().start() + 1;
+  const auto regexp_start = source_range.start() + 1;
 
   // Skip ending "/" if available
-  const auto regexp_end = source_code().CharAt(source.range().end() - 1) == '/'
-                              ? source.range().end() - 1
-                              : source.range().end();
+  const auto regexp_end = source_code().CharAt(source_range.end() - 1) == '/'
+                              ? source_range.end() - 1
+                              : source_range.end();
   const auto& regexp =
       RegExpParser(&context_, source_code().Slice(regexp_start, regexp_end),
                    options_)
@@ -700,28 +792,31 @@ const ast::Node& Parser::ParseRegExpLiteral() {
     return node_factory().NewRegExpLiteralExpression(GetSourceCodeRange(),
                                                      regexp, NewEmptyName());
   }
-  auto& flags = CanPeekToken() && PeekToken() == ast::SyntaxCode::Name
+  auto& flags = CanPeekToken() && PeekTokenIs(ast::SyntaxCode::Name)
                     ? ConsumeToken()
                     : NewEmptyName();
   return node_factory().NewRegExpLiteralExpression(GetSourceCodeRange(), regexp,
                                                    flags);
 }
 
+// Prefix operators are parsed with explicit stack of operators.
 const ast::Node& Parser::ParseUnaryExpression() {
   NodeRangeScope scope(this);
-  if (IsUnaryOperator(PeekToken())) {
-    auto& token = ConsumeToken();
-    auto& expression = ParseUnaryExpression();
-    return NewUnaryExpression(token, expression);
+  std::vector<std::pair<const ast::Node*, int>> operators;
+  while (IsUnaryOperator(PeekToken()) || IsKeywordOperator(PeekToken())) {
+    const auto start = PeekTokenRange().start();
+    operators.emplace_back(&ConsumeToken(), start);
   }
-  if (IsKeywordOperator(PeekToken())) {
-    auto& token = ConsumeToken();
-    auto& expression = ParseUnaryExpression();
-    return NewUnaryExpression(token, expression);
+  auto* expression = PeekTokenIs(ast::TokenKind::Yield)
+                         ? &ParseYieldExpression()
+                         : &ParseUpdateExpression();
+  while (!operators.empty()) {
+    // |NodeRangeScope| restores |node_start_|.
+    node_start_ = operators.back().second;
+    expression = &NewUnaryExpression(*operators.back().first, *expression);
+    operators.pop_back();
   }
-  if (PeekToken() == ast::TokenKind::Yield)
-    return ParseYieldExpression();
-  return ParseUpdateExpression();
+  return *expression;
 }
 
 const ast::Node& Parser::ParseUpdateExpression() {
@@ -739,7 +834,8 @@ const ast::Node& Parser::ParseUpdateExpression() {
       AddError(ErrorCode::ERROR_EXPRESSION_UNEXPECT_NEWLINE);
     return expression;
   }
-  auto& op = ConvertToPostOperator(&node_factory(), ConsumeToken());
+  const auto& token = ConsumeToken();
+  auto& op = ConvertToPostOperator(&node_factory(), token, RangeOf(token));
   return NewUnaryExpression(op, expression);
 }
 
@@ -748,14 +844,14 @@ const ast::Node& Parser::ParseYieldExpression() {
   auto& keyword = ConsumeToken();
   if (!CanPeekToken())
     return NewUnaryExpression(keyword, NewElisionExpression());
-  if (PeekToken() == ast::TokenKind::Times) {
+  if (PeekTokenIs(ast::TokenKind::Times)) {
     auto& yield_star = node_factory().NewName(
-        SourceCodeRange::Merge(keyword.range(), lexer_->location()),
+        SourceCodeRange::Merge(RangeOf(keyword), lexer_->location()),
         ast::TokenKind::YieldStar);
-    ConsumeToken();
+    Advance();
     return NewUnaryExpression(yield_star, ParseAssignmentExpression());
   }
-  if (PeekToken() == ast::TokenKind::Semicolon)
+  if (PeekTokenIs(ast::TokenKind::Semicolon))
     return NewUnaryExpression(keyword, NewElisionExpression());
   return NewUnaryExpression(keyword, ParseAssignmentExpression());
 }
@@ -767,7 +863,7 @@ const ast::Node& Parser::TryAnnotate(const ast::Node* maybe_document,
   const auto& document = *maybe_document;
   DCHECK_EQ(document, ast::SyntaxCode::JsDocDocument);
   return node_factory().NewAnnotation(
-      SourceCodeRange::Merge(document.range(), expression.range()), document,
+      SourceCodeRange::Merge(RangeOf(document), RangeOf(expression)), document,
       expression);
 }
 
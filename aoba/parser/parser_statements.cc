@@ -12,6 +12,7 @@
 #include "aoba/ast/expressions.h"
 #include "aoba/ast/node.h"
 #include "aoba/ast/node_factory.h"
+#include "aoba/ast/node_list_builder.h"
 #include "aoba/ast/statements.h"
 #include "aoba/ast/tokens.h"
 #include "aoba/base/source_code.h"
@@ -73,9 +74,9 @@ const ast::Node& Parser::HandleLabeledStatement(const ast::Node& label) {
   auto& colon = ConsumeToken();
   DCHECK_EQ(colon, ast::TokenKind::Colon);
   if (!options_.disable_automatic_semicolon()) {
-    if (!CanPeekToken() || PeekToken() == ast::TokenKind::RightBrace) {
+    if (!CanPeekToken() || PeekTokenIs(ast::TokenKind::RightBrace)) {
       auto& statement =
-          NewEmptyStatement(SourceCodeRange::CollapseToEnd(colon.range()));
+          NewEmptyStatement(SourceCodeRange::CollapseToEnd(RangeOf(colon)));
       return node_factory().NewLabeledStatement(GetSourceCodeRange(), label,
                                                 statement);
     }
@@ -116,14 +117,14 @@ const ast::Node& Parser::ParseJsDocAsStatement() {
     return node_factory().NewAnnotation(
         GetSourceCodeRange(), jsdoc,
         node_factory().NewDeclaration(
-            expression.range(),
+            RangeOf(expression),
             ast::AssignmentExpression::LeftHandSideOf(expression),
             ast::AssignmentExpression::RightHandSideOf(expression)));
   }
   if (IsMemberExpression(expression)) {
     return node_factory().NewAnnotation(
         GetSourceCodeRange(), jsdoc,
-        node_factory().NewDeclaration(expression.range(), expression,
+        node_factory().NewDeclaration(RangeOf(expression), expression,
                                       NewElisionExpression(expression)));
   }
   AddError(jsdoc, ErrorCode::ERROR_STATEMENT_UNEXPECT_ANNOTATION);
@@ -132,9 +133,9 @@ const ast::Node& Parser::ParseJsDocAsStatement() {
 
 const ast::Node& Parser::ParseBlockStatement() {
   NodeRangeScope scope(this);
-  DCHECK_EQ(PeekToken(), ast::TokenKind::LeftBrace);
-  ConsumeToken();
-  std::vector<const ast::Node*> statements;
+  DCHECK(PeekTokenIs(ast::TokenKind::LeftBrace));
+  Advance();
+  ast::NodeListBuilder statements(&node_factory());
   while (CanPeekToken()) {
     if (ConsumeTokenIf(ast::TokenKind::RightBrace))
       break;
@@ -142,18 +143,18 @@ const ast::Node& Parser::ParseBlockStatement() {
       continue;
     statements.push_back(&ParseStatement());
   }
-  return node_factory().NewBlockStatement(GetSourceCodeRange(), statements);
+  return node_factory().NewBlockStatement(GetSourceCodeRange(), &statements);
 }
 
 const ast::Node& Parser::ParseBreakStatement() {
-  ConsumeToken();
+  Advance();
   if (is_separated_by_newline_) {
     if (options_.disable_automatic_semicolon())
       AddError(ErrorCode::ERROR_STATEMENT_UNEXPECT_NEWLINE);
     return node_factory().NewBreakStatement(GetSourceCodeRange(),
                                             NewEmptyName());
   }
-  auto& label = CanPeekToken() && PeekToken() == ast::SyntaxCode::Name
+  auto& label = CanPeekToken() && PeekTokenIs(ast::SyntaxCode::Name)
                     ? ConsumeToken()
                     : NewEmptyName();
   ExpectSemicolon();
@@ -162,19 +163,19 @@ const ast::Node& Parser::ParseBreakStatement() {
 
 const ast::Node& Parser::ParseCaseClause() {
   NodeRangeScope scope(this);
-  DCHECK_EQ(PeekToken(), ast::TokenKind::Case);
-  ConsumeToken();
+  DCHECK(PeekTokenIs(ast::TokenKind::Case));
+  Advance();
   auto& expression = ParseExpression();
-  if (!CanPeekToken() || PeekToken() != ast::TokenKind::Colon) {
+  if (!CanPeekToken() || !PeekTokenIs(ast::TokenKind::Colon)) {
     AddError(ErrorCode::ERROR_STATEMENT_EXPECT_COLON);
   } else {
     auto& colon = ConsumeToken();
-    if (CanPeekToken() && PeekToken() == ast::TokenKind::RightBrace) {
+    if (CanPeekToken() && PeekTokenIs(ast::TokenKind::RightBrace)) {
       if (options_.disable_automatic_semicolon())
         AddError(ErrorCode::ERROR_STATEMENT_EXPECT_SEMICOLON);
       return node_factory().NewCaseClause(
           GetSourceCodeRange(), expression,
-          NewEmptyStatement(SourceCodeRange::CollapseToEnd(colon.range())));
+          NewEmptyStatement(SourceCodeRange::CollapseToEnd(RangeOf(colon))));
     }
   }
   auto& statement = ParseStatement();
@@ -183,22 +184,22 @@ const ast::Node& Parser::ParseCaseClause() {
 }
 
 const ast::Node& Parser::ParseConstStatement() {
-  DCHECK_EQ(PeekToken(), ast::TokenKind::Const);
-  ConsumeToken();
+  DCHECK(PeekTokenIs(ast::TokenKind::Const));
+  Advance();
   const auto& elements = ParseBindingElements();
   ExpectSemicolon();
   return node_factory().NewConstStatement(GetSourceCodeRange(), elements);
 }
 
 const ast::Node& Parser::ParseContinueStatement() {
-  ConsumeToken();
+  Advance();
   if (is_separated_by_newline_) {
     if (options_.disable_automatic_semicolon())
       AddError(ErrorCode::ERROR_STATEMENT_UNEXPECT_NEWLINE);
     return node_factory().NewContinueStatement(GetSourceCodeRange(),
                                                NewEmptyName());
   }
-  auto& label = CanPeekToken() && PeekToken() == ast::SyntaxCode::Name
+  auto& label = CanPeekToken() && PeekTokenIs(ast::SyntaxCode::Name)
                     ? ConsumeToken()
                     : NewEmptyName();
   ExpectSemicolon();
@@ -207,16 +208,16 @@ const ast::Node& Parser::ParseContinueStatement() {
 
 const ast::Node& Parser::ParseDefaultLabel() {
   NodeRangeScope scope(this);
-  DCHECK_EQ(PeekToken(), ast::TokenKind::Default);
+  DCHECK(PeekTokenIs(ast::TokenKind::Default));
   auto& label = ConsumeToken();
-  if (!CanPeekToken() || PeekToken() != ast::TokenKind::Colon)
+  if (!CanPeekToken() || !PeekTokenIs(ast::TokenKind::Colon))
     return NewInvalidStatement(ErrorCode::ERROR_STATEMENT_EXPECT_COLON);
   return HandleLabeledStatement(label);
 }
 
 const ast::Node& Parser::ParseDoStatement() {
-  DCHECK_EQ(PeekToken(), ast::TokenKind::Do);
-  ConsumeToken();
+  DCHECK(PeekTokenIs(ast::TokenKind::Do));
+  Advance();
   auto& statement = ParseStatement();
   if (!ConsumeTokenIf(ast::TokenKind::While))
     return NewInvalidStatement(ErrorCode::ERROR_STATEMENT_EXPECT_WHILE);
@@ -244,13 +245,13 @@ const ast::Node& Parser::ParseExpressionStatement() {
 }
 
 const ast::Node& Parser::ParseForStatement() {
-  DCHECK_EQ(PeekToken(), ast::TokenKind::For);
-  ConsumeToken();
+  DCHECK(PeekTokenIs(ast::TokenKind::For));
+  Advance();
   ExpectPunctuator(ast::TokenKind::LeftParenthesis,
                    ErrorCode::ERROR_STATEMENT_EXPECT_LPAREN);
 
   const auto* const document =
-      CanPeekToken() && PeekToken() == ast::SyntaxCode::JsDocDocument
+      CanPeekToken() && PeekTokenIs(ast::SyntaxCode::JsDocDocument)
           ? &ConsumeToken()
           : nullptr;
 
@@ -263,19 +264,19 @@ const ast::Node& Parser::ParseForStatement() {
       AddError(*document, ErrorCode::ERROR_STATEMENT_UNEXPECT_ANNOTATION);
 
     const auto& expression =
-        CanPeekToken() && PeekToken() == ast::TokenKind::Semicolon
+        CanPeekToken() && PeekTokenIs(ast::TokenKind::Semicolon)
             ? NewElisionExpression()
             : ParseExpression();
     if (ConsumeTokenIf(ast::TokenKind::Semicolon)) {
       // 'for' '(' expression ';' condition ';' step ')' statement
       const auto& condition =
-          CanPeekToken() && PeekToken() == ast::TokenKind::Semicolon
+          CanPeekToken() && PeekTokenIs(ast::TokenKind::Semicolon)
               ? NewElisionExpression()
               : ParseExpression();
       ExpectPunctuator(ast::TokenKind::Semicolon,
                        ErrorCode::ERROR_STATEMENT_EXPECT_SEMICOLON);
       const auto& step =
-          CanPeekToken() && PeekToken() == ast::TokenKind::RightParenthesis
+          CanPeekToken() && PeekTokenIs(ast::TokenKind::RightParenthesis)
               ? NewElisionExpression()
               : ParseExpression();
       ExpectPunctuator(ast::TokenKind::RightParenthesis,
@@ -343,13 +344,13 @@ const ast::Node& Parser::ParseForStatement() {
   if (ConsumeTokenIf(ast::TokenKind::Semicolon)) {
     // 'for' '(' keyword binding ';' condition? ';' step? ')
     const auto& condition =
-        CanPeekToken() && PeekToken() == ast::TokenKind::Semicolon
+        CanPeekToken() && PeekTokenIs(ast::TokenKind::Semicolon)
             ? NewElisionExpression()
             : ParseExpression();
     ExpectPunctuator(ast::TokenKind::Semicolon,
                      ErrorCode::ERROR_STATEMENT_EXPECT_SEMICOLON);
     const auto& step =
-        CanPeekToken() && PeekToken() == ast::TokenKind::RightParenthesis
+        CanPeekToken() && PeekTokenIs(ast::TokenKind::RightParenthesis)
             ? NewElisionExpression()
             : ParseExpression();
     ExpectPunctuator(ast::TokenKind::RightParenthesis,
@@ -382,8 +383,8 @@ const ast::Node& Parser::ParseKeywordStatement() {
   DCHECK(ast::Name::IsKeyword(keyword)) << keyword;
   switch (ast::Name::KindOf(keyword)) {
     case ast::TokenKind::Async:
-      ConsumeToken();
-      if (CanPeekToken() && PeekToken() == ast::TokenKind::Function)
+      Advance();
+      if (CanPeekToken() && PeekTokenIs(ast::TokenKind::Function))
         return ParseFunction(ast::FunctionKind::Async);
       PushBackToken(keyword);
       break;
@@ -410,7 +411,7 @@ const ast::Node& Parser::ParseKeywordStatement() {
     case ast::TokenKind::For:
       return ParseForStatement();
     case ast::TokenKind::Function:
-      ConsumeToken();
+      Advance();
       if (ConsumeTokenIf(ast::TokenKind::Times))
         return ParseFunction(ast::FunctionKind::Generator);
       return ParseFunction(ast::FunctionKind::Normal);
@@ -445,7 +446,7 @@ const ast::Node& Parser::ParseKeywordStatement() {
     case ast::TokenKind::Protected:
     case ast::TokenKind::Public:
     case ast::TokenKind::Static:
-      ConsumeToken();
+      Advance();
       return NewInvalidStatement(ErrorCode::ERROR_STATEMENT_RESERVED_WORD);
     default:
       // An expression starts with keyword.
@@ -455,8 +456,8 @@ const ast::Node& Parser::ParseKeywordStatement() {
 }
 
 const ast::Node& Parser::ParseLetStatement() {
-  DCHECK_EQ(PeekToken(), ast::TokenKind::Let);
-  ConsumeToken();
+  DCHECK(PeekTokenIs(ast::TokenKind::Let));
+  Advance();
   const auto& elements = ParseBindingElements();
   ExpectSemicolon();
   return node_factory().NewLetStatement(GetSourceCodeRange(), elements);
@@ -466,7 +467,7 @@ const ast::Node& Parser::ParseNameAsStatement() {
   auto& name = PeekToken();
   if (ast::Name::IsKeyword(name))
     return ParseKeywordStatement();
-  ConsumeToken();
+  Advance();
   if (!CanPeekToken()) {
     PushBackToken(name);
     return ParseExpressionStatement();
@@ -475,7 +476,7 @@ const ast::Node& Parser::ParseNameAsStatement() {
     if (options_.disable_automatic_semicolon())
       AddError(ErrorCode::ERROR_STATEMENT_UNEXPECT_NEWLINE);
   } else {
-    if (CanPeekToken() && PeekToken() == ast::TokenKind::Colon)
+    if (CanPeekToken() && PeekTokenIs(ast::TokenKind::Colon))
       return HandleLabeledStatement(name);
   }
   PushBackToken(name);
@@ -497,14 +498,14 @@ const ast::Node& Parser::ParseParenthesisExpression() {
 }
 
 const ast::Node& Parser::ParseReturnStatement() {
-  ConsumeToken();
+  Advance();
   if (is_separated_by_newline_) {
     if (options_.disable_automatic_semicolon())
       AddError(ErrorCode::ERROR_STATEMENT_UNEXPECT_NEWLINE);
     return node_factory().NewReturnStatement(GetSourceCodeRange(),
                                              NewElisionExpression());
   } else {
-    if (CanPeekToken() && PeekToken() == ast::TokenKind::RightBrace) {
+    if (CanPeekToken() && PeekTokenIs(ast::TokenKind::RightBrace)) {
       return node_factory().NewReturnStatement(GetSourceCodeRange(),
                                                NewElisionExpression());
     }
@@ -534,16 +535,16 @@ const ast::Node& Parser::ParseStatement() {
     return ParseBlockStatement();
   if (token == ast::TokenKind::Semicolon) {
     auto& statement = NewEmptyStatement(
-        SourceCodeRange::CollapseToStart(PeekToken().range()));
-    ConsumeToken();
+        SourceCodeRange::CollapseToStart(PeekTokenRange()));
+    Advance();
     return statement;
   }
   return ParseExpressionStatement();
 }
 
 const ast::Node& Parser::ParseSwitchStatement() {
-  DCHECK_EQ(PeekToken(), ast::TokenKind::Switch);
-  ConsumeToken();
+  DCHECK(PeekTokenIs(ast::TokenKind::Switch));
+  Advance();
   auto& expression = ParseParenthesisExpression();
   std::vector<const ast::Node*> clauses;
   if (!ConsumeTokenIf(ast::TokenKind::LeftBrace)) {
@@ -561,15 +562,15 @@ const ast::Node& Parser::ParseSwitchStatement() {
 }
 
 const ast::Node& Parser::ParseThrowStatement() {
-  DCHECK_EQ(PeekToken(), ast::TokenKind::Throw);
-  ConsumeToken();
+  DCHECK(PeekTokenIs(ast::TokenKind::Throw));
+  Advance();
   auto& expression = ParseExpression();
   ExpectSemicolon();
   return node_factory().NewThrowStatement(GetSourceCodeRange(), expression);
 }
 
 const ast::Node& Parser::ParseTryStatement() {
-  ConsumeToken();
+  Advance();
   auto& try_block = ParseStatement();
   if (ConsumeTokenIf(ast::TokenKind::Finally)) {
     auto& finally_block = ParseBlockStatement();
@@ -589,7 +590,7 @@ const ast::Node& Parser::ParseTryStatement() {
   ConsumeTokenIf(ast::TokenKind::RightParenthesis);
   const auto& catch_block = ParseStatement();
   const auto& catch_clause = node_factory().NewCatchClause(
-      SourceCodeRange::Merge(catch_token.range(), catch_block.range()),
+      SourceCodeRange::Merge(RangeOf(catch_token), RangeOf(catch_block)),
       catch_parameter, catch_block);
   if (!ConsumeTokenIf(ast::TokenKind::Finally)) {
     return node_factory().NewTryCatchStatement(GetSourceCodeRange(), try_block,
@@ -601,16 +602,16 @@ const ast::Node& Parser::ParseTryStatement() {
 }
 
 const ast::Node& Parser::ParseVarStatement() {
-  DCHECK_EQ(PeekToken(), ast::TokenKind::Var);
-  ConsumeToken();
+  DCHECK(PeekTokenIs(ast::TokenKind::Var));
+  Advance();
   const auto& elements = ParseBindingElements();
   ExpectSemicolon();
   return node_factory().NewVarStatement(GetSourceCodeRange(), elements);
 }
 
 const ast::Node& Parser::ParseWhileStatement() {
-  DCHECK_EQ(PeekToken(), ast::TokenKind::While);
-  ConsumeToken();
+  DCHECK(PeekTokenIs(ast::TokenKind::While));
+  Advance();
   auto& condition = ParseParenthesisExpression();
   auto& statement = ParseStatement();
   return node_factory().NewWhileStatement(GetSourceCodeRange(), condition,
@@ -618,8 +619,8 @@ const ast::Node& Parser::ParseWhileStatement() {
 }
 
 const ast::Node& Parser::ParseWithStatement() {
-  DCHECK_EQ(PeekToken(), ast::TokenKind::With);
-  ConsumeToken();
+  DCHECK(PeekTokenIs(ast::TokenKind::With));
+  Advance();
   auto& expression = ParseParenthesisExpression();
   auto& statement = ParseStatement();
   return node_factory().NewWithStatement(GetSourceCodeRange(), expression,
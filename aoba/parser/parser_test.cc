@@ -247,6 +247,25 @@ TEST_F(ParserTest, AnnotateStatement) {
       << "Parser does not check statement can have annotation";
 }
 
+TEST_F(ParserTest, AnnotationSkipped) {
+  EXPECT_EQ(
+      "Module\n"
+      "+--VarStatement\n"
+      "|  +--ArrayBindingPattern\n"
+      "|  |  +--ReferenceExpression\n"
+      "|  |  |  +--Name |x|\n"
+      "|  |  +--BindingNameElement\n"
+      "|  |  |  +--Name |a|\n"
+      "|  |  |  +--ElisionExpression ||\n"
+      "JSDOC_ERROR_TAG_EXPECT_LBRACE@11:21\n"
+      "JSDOC_ERROR_TAG_EXPECT_NAME@21:21\n"
+      "JSDOC_ERROR_TAG_EXPECT_ARGUMENTS_OR_THIS@11:21\n"
+      "JSDOC_ERROR_TAG_EXPECT_RBRACE@11:21\n"
+      "PASER_ERROR_BINDING_INVALID_ELEMENT@5:6\n",
+      Parse("var [1 /** @modifies */, a] = x;"))
+      << "Errors of JsDoc document skipped by error recovery";
+}
+
 TEST_F(ParserTest, AsyncFunction) {
   EXPECT_EQ(
       "Module\n"
@@ -678,6 +697,52 @@ TEST_F(ParserTest, ExpressionArrowFunction0) {
       Parse("(x, y) => x * y;"));
 }
 
+TEST_F(ParserTest, ExpressionArrowFunctionError) {
+  EXPECT_EQ(
+      "Module\n"
+      "+--ExpressionStatement\n"
+      "|  +--CallExpression\n"
+      "|  |  +--ReferenceExpression\n"
+      "|  |  |  +--Name |f|\n"
+      "|  |  +--ArrowFunction\n"
+      "|  |  |  +--ParameterList\n"
+      "|  |  |  |  +--BindingNameElement\n"
+      "|  |  |  |  |  +--Name |a|\n"
+      "|  |  |  |  |  +--ElisionExpression ||\n"
+      "|  |  |  |  +--BindingNameElement\n"
+      "|  |  |  |  |  +--Name |b|\n"
+      "|  |  |  |  |  +--ElisionExpression ||\n"
+      "|  |  |  +--ReferenceExpression\n"
+      "|  |  |  |  +--Name |a|\n"
+      "PASER_ERROR_EXPRESSION_ARGUMENT_LIST_EXPECT_RPAREN@13:14\n"
+      "PASER_ERROR_BRACKET_EXPECT_RPAREN@1:14\n",
+      Parse("f((a, b) => a;"))
+      << "Error after arrow function with parenthesized parameters";
+
+  EXPECT_EQ(
+      "Module\n"
+      "+--ExpressionStatement\n"
+      "|  +--AssignmentExpression<=>\n"
+      "|  |  +--ReferenceExpression\n"
+      "|  |  |  +--Name |x|\n"
+      "|  |  +--Punctuator |=|\n"
+      "|  |  +--ArrowFunction\n"
+      "|  |  |  +--ParameterList\n"
+      "|  |  |  |  +--BindingNameElement\n"
+      "|  |  |  |  |  +--Name |a|\n"
+      "|  |  |  |  |  +--ElisionExpression ||\n"
+      "|  |  |  |  +--BindingNameElement\n"
+      "|  |  |  |  |  +--Name |b|\n"
+      "|  |  |  |  |  +--ElisionExpression ||\n"
+      "|  |  |  +--BlockStatement\n"
+      "|  |  |  |  +--ExpressionStatement\n"
+      "|  |  |  |  |  +--ReferenceExpression\n"
+      "|  |  |  |  |  |  +--Name |c|\n"
+      "PASER_ERROR_BRACKET_EXPECT_RBRACE@14:21\n",
+      Parse("x = (a, b) => {\n  c\n;"))
+      << "Error in arrow function body";
+}
+
 TEST_F(ParserTest, ExpressionAssignment1) {
   EXPECT_EQ(
       "Module\n"
@@ -764,6 +829,32 @@ TEST_F(ParserTest, ExpressionBinary2) {
       Parse("(1 + 2) * 3;"));
 }
 
+TEST_F(ParserTest, ExpressionBinary3) {
+  EXPECT_EQ(
+      "Module\n"
+      "+--ExpressionStatement\n"
+      "|  +--BinaryExpression<||>\n"
+      "|  |  +--BinaryExpression<<>\n"
+      "|  |  |  +--BinaryExpression<+>\n"
+      "|  |  |  |  +--BinaryExpression<*>\n"
+      "|  |  |  |  |  +--NumericLiteral |1|\n"
+      "|  |  |  |  |  +--Punctuator |*|\n"
+      "|  |  |  |  |  +--NumericLiteral |2|\n"
+      "|  |  |  |  +--Punctuator |+|\n"
+      "|  |  |  |  +--NumericLiteral |3|\n"
+      "|  |  |  +--Punctuator |<|\n"
+      "|  |  |  +--NumericLiteral |4|\n"
+      "|  |  +--Punctuator ||||\n"
+      "|  |  +--BinaryExpression<->\n"
+      "|  |  |  +--BinaryExpression<->\n"
+      "|  |  |  |  +--NumericLiteral |5|\n"
+      "|  |  |  |  +--Punctuator |-|\n"
+      "|  |  |  |  +--NumericLiteral |6|\n"
+      "|  |  |  +--Punctuator |-|\n"
+      "|  |  |  +--NumericLiteral |7|\n",
+      Parse("1 * 2 + 3 < 4 || 5 - 6 - 7;"));
+}
+
 TEST_F(ParserTest, ExpressionCall0) {
   EXPECT_EQ(
       "Module\n"
@@ -1035,6 +1126,49 @@ TEST_F(ParserTest, ExpressionConditional) {
       Parse("foo ? bar : baz;"));
 }
 
+TEST_F(ParserTest, ExpressionConditional2) {
+  EXPECT_EQ(
+      "Module\n"
+      "+--ExpressionStatement\n"
+      "|  +--ConditionalExpression\n"
+      "|  |  +--ReferenceExpression\n"
+      "|  |  |  +--Name |a|\n"
+      "|  |  +--ReferenceExpression\n"
+      "|  |  |  +--Name |b|\n"
+      "|  |  +--ConditionalExpression\n"
+      "|  |  |  +--ReferenceExpression\n"
+      "|  |  |  |  +--Name |c|\n"
+      "|  |  |  +--AssignmentExpression<=>\n"
+      "|  |  |  |  +--ReferenceExpression\n"
+      "|  |  |  |  |  +--Name |d|\n"
+      "|  |  |  |  +--Punctuator |=|\n"
+      "|  |  |  |  +--ReferenceExpression\n"
+      "|  |  |  |  |  +--Name |e|\n"
+      "|  |  |  +--ReferenceExpression\n"
+      "|  |  |  |  +--Name |f|\n",
+      Parse("a ? b : c ? d = e : f;"));
+}
+
+// Long chains of expressions should not exhaust native stack.
+TEST_F(ParserTest, ExpressionDeepChain) {
+  const auto kDepth = 100000;
+  const char* const kChains[][2] = {
+      {"a = ", "b;"}, {"a ? b : ", "c;"}, {"a + ", "b;"},
+      {"!", "a;"},    {"new ", "X;"},
+  };
+  for (const auto& chain : kChains) {
+    std::string script_text;
+    for (auto count = 0; count < kDepth; ++count)
+      script_text += chain[0];
+    script_text += chain[1];
+    PrepareSouceCode(script_text);
+    const ParserOptions options;
+    Parser parser(&context(), source_code().range(), options);
+    parser.Run();
+    EXPECT_TRUE(error_sink().errors().empty()) << chain[0];
+  }
+}
+
 TEST_F(ParserTest, ExpressionMember) {
   EXPECT_EQ(
       "Module\n"
@@ -17,7 +17,9 @@ namespace aoba {
   V(enable_strict_backslash, bool, false,                              \
     "If true, a character after backslash should be one of '\\bfntv'") \
   V(enable_strict_regexp, bool, false,                                 \
-    "If true, RegExp syntax characters should be escaped.")
+    "If true, RegExp syntax characters should be escaped.")            \
+  V(number_of_lexer_threads, int, 1,                                   \
+    "If greater than one, large source code is lexed in parallel.")
 
 //
 // ParserOptions
@@ -49,7 +49,7 @@ class RegExpParser::ScopedNodeFactory final {
 };
 
 RegExpParser::ScopedNodeFactory::ScopedNodeFactory(RegExpParser* parser)
-    : parser_(*parser), start_(parser->PeekToken().range().start()) {}
+    : parser_(*parser), start_(parser->RangeOf(parser->PeekToken()).start()) {}
 
 RegExpParser::ScopedNodeFactory::~ScopedNodeFactory() = default;
 
@@ -63,8 +63,8 @@ void RegExpParser::ScopedNodeFactory::AddError(RegExpErrorCode error_code) {
 }
 
 SourceCodeRange RegExpParser::ScopedNodeFactory::ComputeRange() const {
-  return parser_.source_code().Slice(start_,
-                                     parser_.last_token_->range().end());
+  return parser_.source_code().Slice(
+      start_, parser_.RangeOf(*parser_.last_token_).end());
 }
 
 const ast::Node& RegExpParser::ScopedNodeFactory::NewCapture(
@@ -132,11 +132,15 @@ const SourceCode& RegExpParser::source_code() const {
   return lexer_->source_code();
 }
 
+SourceCodeRange RegExpParser::RangeOf(const ast::Node& node) const {
+  return node.location().ToRange(source_code());
+}
+
 const ast::Node& RegExpParser::ParseOr() {
   ScopedNodeFactory factory(this);
   std::vector<const ast::Node*> members;
   if (CanPeekToken() && PeekToken() == ast::TokenKind::BitOr)
-    members.push_back(&NewEmpty(PeekToken().range()));
+    members.push_back(&NewEmpty(RangeOf(PeekToken())));
   else
     members.push_back(&ParseSequence());
   while (CanPeekToken() && ConsumeTokenIf(ast::TokenKind::BitOr)) {
@@ -146,11 +150,11 @@ const ast::Node& RegExpParser::ParseOr() {
       break;
     }
     if (PeekToken() == ast::TokenKind::RightParenthesis) {
-      members.push_back(&NewEmpty(PeekToken().range()));
+      members.push_back(&NewEmpty(RangeOf(PeekToken())));
       break;
     }
     if (PeekToken() == ast::TokenKind::BitOr) {
-      members.push_back(&NewEmpty(ConsumeToken().range()));
+      members.push_back(&NewEmpty(RangeOf(ConsumeToken())));
       continue;
     }
     members.push_back(&ParseSequence());
@@ -184,7 +188,7 @@ const ast::Node& RegExpParser::ParsePrimary() {
   const auto& token = ConsumeToken();
   if (options_.enable_strict_regexp())
     return factory.NewError(RegExpErrorCode::REGEXP_EXPECT_PRIMARY);
-  return node_factory().NewLiteralRegExp(token.range());
+  return node_factory().NewLiteralRegExp(RangeOf(token));
 }
 
 const ast::Node& RegExpParser::ParseParenthesis() {
@@ -193,12 +197,12 @@ const ast::Node& RegExpParser::ParseParenthesis() {
     // In case of /(?:)/
     return factory.NewSequence({});
   }
-  groups_.push(last_token_->range().start());
+  groups_.push(RangeOf(*last_token_).start());
   const auto& pattern = ParseOr();
   DCHECK(!groups_.empty());
   if (!ConsumeTokenIf(ast::TokenKind::RightParenthesis)) {
     factory.AddError(
-        source_code().Slice(groups_.top(), last_token_->range().end()),
+        source_code().Slice(groups_.top(), RangeOf(*last_token_).end()),
         RegExpErrorCode::REGEXP_EXPECT_RPAREN);
   }
   groups_.pop();
@@ -233,7 +237,7 @@ const ast::Node& RegExpParser::ParseSequence() {
     auto& pattern = ParseRepeat();
     if (!patterns.empty() && CanMergeNodes(*patterns.back(), pattern)) {
       auto& merged = node_factory().NewLiteralRegExp(
-          SourceCodeRange::Merge(patterns.back()->range(), pattern.range()));
+          SourceCodeRange::Merge(RangeOf(*patterns.back()), RangeOf(pattern)));
       patterns.pop_back();
       patterns.push_back(&merged);
       continue;
@@ -46,6 +46,7 @@ class RegExpParser final {
   ParserContext& context() const { return context_; }
   ast::NodeFactory& node_factory() const;
   const SourceCode& source_code() const;
+  SourceCodeRange RangeOf(const ast::Node& node) const;
 
   const ast::Node& ParseOr();
   const ast::Node& ParsePrimary();
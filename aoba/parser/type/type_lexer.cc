@@ -95,11 +95,13 @@ const ast::Node& TypeLexer::NewPunctuator(ast::TokenKind kind) {
 const ast::Node* TypeLexer::NextToken() {
 start_over:
   auto found_newline = false;
-  while (CanPeekChar() && IsWhitespace(PeekChar())) {
-    if (IsLineTerminator(PeekChar()))
+  reader_->ConsumeWhile([&](base::char16 char_code) {
+    if (!IsWhitespace(char_code))
+      return false;
+    if (IsLineTerminator(char_code))
       found_newline = true;
-    ConsumeChar();
-  }
+    return true;
+  });
   if (!CanPeekChar())
     return nullptr;
   if (mode_ == TypeLexerMode::JsDoc && found_newline && ConsumeCharIf('*'))
@@ -165,8 +167,7 @@ start_over:
   }
   if (IsIdentifierStart(PeekChar())) {
     ConsumeChar();
-    while (CanPeekChar() && IsIdentifierPart(PeekChar()))
-      ConsumeChar();
+    reader_->ConsumeWhile(IsIdentifierPart);
     return &node_factory().NewName(ComputeTokenRange());
   }
   ConsumeChar();
@@ -67,7 +67,7 @@ class TypeParser::TypeNodeScope final {
  public:
   explicit TypeNodeScope(TypeParser* parser)
       : parser_(*parser), node_start_(parser->node_start_) {
-    parser_.node_start_ = parser_.PeekToken().range().start();
+    parser_.node_start_ = parser_.RangeOf(parser_.PeekToken()).start();
   }
 
   ~TypeNodeScope() { parser_.node_start_ = node_start_; }
@@ -106,6 +106,10 @@ const SourceCode& TypeParser::source_code() const {
   return lexer_->source_code();
 }
 
+SourceCodeRange TypeParser::RangeOf(const ast::Node& node) const {
+  return node.location().ToRange(source_code());
+}
+
 void TypeParser::AddError(int start, int end, TypeErrorCode error_code) {
   AddError(source_code().Slice(start, end), error_code);
 }
@@ -116,12 +120,12 @@ void TypeParser::AddError(const SourceCodeRange& range,
 }
 
 void TypeParser::AddError(const ast::Node& token, TypeErrorCode error_code) {
-  AddError(token.range(), error_code);
+  AddError(RangeOf(token), error_code);
 }
 
 void TypeParser::AddError(TypeErrorCode error_code) {
   if (CanPeekToken())
-    return AddError(PeekToken().range(), error_code);
+    return AddError(RangeOf(PeekToken()), error_code);
   AddError(lexer_->location(), error_code);
 }
 
@@ -148,7 +152,7 @@ void TypeParser::SkipTokensTo(ast::TokenKind kind) {
 SourceCodeRange TypeParser::ComputeNodeRange() const {
   if (!CanPeekToken())
     return source_code().Slice(node_start_, lexer_->range().end());
-  return source_code().Slice(node_start_, PeekToken().range().end());
+  return source_code().Slice(node_start_, RangeOf(PeekToken()).end());
 }
 
 const ast::Node& TypeParser::NewAnyType() {
@@ -189,7 +193,7 @@ const ast::Node& TypeParser::NewOptionalType(const ast::Node& type) {
 
 const ast::Node& TypeParser::NewProperty(const ast::Node& name,
                                          const ast::Node& type) {
-  return node_factory().NewProperty(name.range(), name, type);
+  return node_factory().NewProperty(RangeOf(name), name, type);
 }
 
 const ast::Node& TypeParser::NewRecordType(
@@ -301,7 +305,7 @@ const ast::Node& TypeParser::ParseNonUnionType() {
     const auto& question = ConsumeToken();
     if (CanPeekToken() && CanStartType(PeekToken()))
       return NewNullableType(ParseNonOptionalType());
-    return node_factory().NewUnknownType(question.range());
+    return node_factory().NewUnknownType(RangeOf(question));
   }
   if (ConsumeTokenIf(ast::TokenKind::LogicalNot))
     return NewNonNullableType(ParseNonOptionalType());
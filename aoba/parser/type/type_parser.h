@@ -54,6 +54,7 @@ class TypeParser final {
 
   ast::NodeFactory& node_factory();
   const SourceCode& source_code() const;
+  SourceCodeRange RangeOf(const ast::Node& node) const;
 
   void AddError(int start, int end, TypeErrorCode error_code);
   void AddError(const SourceCodeRange& range, TypeErrorCode error_code);
@@ -50,40 +50,43 @@ ast::TokenKind BracketTracker::close_bracket() const {
   return stack_.top().second->close;
 }
 
-void BracketTracker::Check(const ast::Node& token, const Description& actual) {
-  DCHECK_EQ(token, actual.close);
+void BracketTracker::Check(const SourceCodeRange& range,
+                           const Description& actual) {
   if (stack_.empty()) {
-    error_sink_.AddError(token.range(), actual.close_error);
+    error_sink_.AddError(range, actual.close_error);
     return;
   }
-  const auto& open_token = *stack_.top().first;
-  if (open_token == actual.open) {
+  const auto& open_range = stack_.top().first;
+  if (stack_.top().second->open == actual.open) {
     stack_.pop();
     return;
   }
 
   // We get mismatched close bracket.
-  error_sink_.AddError(
-      SourceCodeRange::Merge(token.range(), open_token.range()),
-      actual.close_error);
+  error_sink_.AddError(SourceCodeRange::Merge(range, open_range),
+                       actual.close_error);
 }
 
-void BracketTracker::Mark(const ast::Node& token,
+void BracketTracker::Mark(const SourceCodeRange& range,
                           const Description& description) {
-  stack_.push(std::make_pair(&token, &description));
+  stack_.push(std::make_pair(range, &description));
 }
 
 void BracketTracker::Feed(const ast::Node& token) {
   if (token != ast::SyntaxCode::Punctuator)
     return;
-  const auto kind = ast::Punctuator::KindOf(token);
+  Feed(ast::Punctuator::KindOf(token),
+       token.location().ToRange(source_code_range_.source_code()));
+}
+
+void BracketTracker::Feed(ast::TokenKind kind, const SourceCodeRange& range) {
   if (kind < min_max_.first || kind > min_max_.second)
     return;
   for (const auto& description : descriptions_) {
     if (kind == description.open)
-      return Mark(token, description);
+      return Mark(range, description);
     if (kind == description.close)
-      return Check(token, description);
+      return Check(range, description);
   }
 }
 
@@ -91,10 +94,10 @@ void BracketTracker::Finish() {
   if (stack_.empty())
     return;
   // Report the last open bracket pair.
-  const auto& open_bracket = *stack_.top().first;
+  const auto& open_range = stack_.top().first;
   const auto& description = *stack_.top().second;
   error_sink_.AddError(
-      source_code_range_.source_code().Slice(open_bracket.range().start(),
+      source_code_range_.source_code().Slice(open_range.start(),
                                              source_code_range_.end()),
       description.open_error);
 }
@@ -10,10 +10,10 @@
 #include <vector>
 
 #include "base/macros.h"
+#include "aoba/base/source_code_range.h"
 
 namespace aoba {
 class ErrorSink;
-class SourceCodeRange;
 
 namespace ast {
 class Node;
@@ -50,17 +50,20 @@ class BracketTracker final {
   size_t depth() const { return stack_.size(); }
 
   void Feed(const ast::Node& token);
+
+  // Feeds punctuator |kind| at |range|.
+  void Feed(ast::TokenKind kind, const SourceCodeRange& range);
   void Finish();
 
  private:
-  void Check(const ast::Node& token, const Description& description);
-  void Mark(const ast::Node& token, const Description& description);
+  void Check(const SourceCodeRange& range, const Description& description);
+  void Mark(const SourceCodeRange& range, const Description& description);
 
   const std::vector<Description> descriptions_;
   ErrorSink& error_sink_;
   const std::pair<ast::TokenKind, ast::TokenKind> min_max_;
-  const SourceCodeRange& source_code_range_;
-  std::stack<std::pair<const ast::Node*, const Description*>> stack_;
+  const SourceCodeRange source_code_range_;
+  std::stack<std::pair<SourceCodeRange, const Description*>> stack_;
 
   DISALLOW_COPY_AND_ASSIGN(BracketTracker);
 };
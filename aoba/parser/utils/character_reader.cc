@@ -4,66 +4,118 @@
 
 #include "aoba/parser/utils/character_reader.h"
 
+#include "aoba/base/character_scanner.h"
 #include "aoba/base/source_code.h"
 #include "aoba/base/source_code_range.h"
 
 namespace aoba {
 namespace parser {
 
+namespace {
+
+const uint8_t* ContentsOf(const SourceCode& source_code) {
+  if (source_code.is_one_byte()) {
+    return reinterpret_cast<const uint8_t*>(
+        source_code.one_byte_contents().data());
+  }
+  return reinterpret_cast<const uint8_t*>(
+      source_code.two_byte_contents().data());
+}
+
+}  // namespace
+
 CharacterReader::CharacterReader(const SourceCodeRange& range)
-    : current_char_offset_(range.start()), range_(range) {
+    : char_shift_(range.source_code().is_one_byte() ? 0 : 1),
+      contents_(ContentsOf(range.source_code())),
+      current_(contents_ + (range.start() << char_shift_)),
+      end_(contents_ + (range.end() << char_shift_)),
+      range_(range) {
   FetchChar();
 }
 
 CharacterReader::~CharacterReader() = default;
 
 int CharacterReader::location() const {
-  return current_char_offset_;
+  return OffsetOf(current_);
 }
 
 const SourceCode& CharacterReader::source_code() const {
   return range_.source_code();
 }
 
-bool CharacterReader::CanPeekChar() const {
-  return current_char_ >= 0;
+bool CharacterReader::ConsumeCharIf(base::char16 char_code) {
+  if (current_char_ != char_code)
+    return false;
+  MoveForward();
+  return true;
 }
 
-base::char16 CharacterReader::PeekChar() const {
-  DCHECK(CanPeekChar());
-  return current_char_;
+int CharacterReader::FindBlockCommentEnd() const {
+  if (char_shift_ == 0) {
+    return OffsetOf(
+        aoba::FindBlockCommentEnd(CurrentAs<uint8_t>(), EndAs<uint8_t>()));
+  }
+  return OffsetOf(aoba::FindBlockCommentEnd(CurrentAs<base::char16>(),
+                                            EndAs<base::char16>()));
 }
 
-base::char16 CharacterReader::ConsumeChar() {
-  const auto result = PeekChar();
-  MoveForward();
-  return result;
+int CharacterReader::FindChar(base::char16 char_code) const {
+  if (char_shift_ == 0) {
+    if (char_code > 0xFF)
+      return range_.end();
+    return OffsetOf(aoba::FindChar(CurrentAs<uint8_t>(), EndAs<uint8_t>(),
+                                   static_cast<uint8_t>(char_code)));
+  }
+  return OffsetOf(aoba::FindChar(CurrentAs<base::char16>(),
+                                 EndAs<base::char16>(), char_code));
 }
 
-bool CharacterReader::ConsumeCharIf(base::char16 char_code) {
-  if (!CanPeekChar() || PeekChar() != char_code)
-    return false;
-  ConsumeChar();
-  return true;
+int CharacterReader::FindLineTerminator() const {
+  if (char_shift_ == 0) {
+    return OffsetOf(
+        aoba::FindLineTerminator(CurrentAs<uint8_t>(), EndAs<uint8_t>()));
+  }
+  return OffsetOf(aoba::FindLineTerminator(CurrentAs<base::char16>(),
+                                           EndAs<base::char16>()));
 }
 
-void CharacterReader::FetchChar() {
-  if (current_char_offset_ == range_.end()) {
-    current_char_ = -1;
-    return;
+bool CharacterReader::HasLineTerminatorBefore(int offset) const {
+  DCHECK_GE(offset, location());
+  DCHECK_LE(offset, range_.end());
+  if (char_shift_ == 0) {
+    return OffsetOf(aoba::FindLineTerminator(
+               CurrentAs<uint8_t>(), PointerAt<uint8_t>(offset))) != offset;
   }
-  current_char_ = source_code().CharAt(current_char_offset_);
+  return OffsetOf(aoba::FindLineTerminator(
+             CurrentAs<base::char16>(), PointerAt<base::char16>(offset))) !=
+         offset;
 }
 
 void CharacterReader::MoveBackward() {
-  DCHECK_GT(current_char_offset_, range_.start());
-  --current_char_offset_;
+  DCHECK_GT(location(), range_.start());
+  current_ -= 1 << char_shift_;
   FetchChar();
 }
 
-void CharacterReader::MoveForward() {
-  DCHECK_LT(current_char_offset_, range_.end());
-  ++current_char_offset_;
+void CharacterReader::MoveTo(int offset) {
+  DCHECK_GE(offset, range_.start());
+  DCHECK_LE(offset, range_.end());
+  current_ = contents_ + (offset << char_shift_);
+  FetchChar();
+}
+
+int CharacterReader::OffsetOf(const void* pointer) const {
+  return static_cast<int>(
+      (static_cast<const uint8_t*>(pointer) - contents_) >> char_shift_);
+}
+
+void CharacterReader::SkipSpaces() {
+  if (char_shift_ == 0) {
+    current_ = aoba::SkipSpaces(CurrentAs<uint8_t>(), EndAs<uint8_t>());
+  } else {
+    current_ = reinterpret_cast<const uint8_t*>(
+        aoba::SkipSpaces(CurrentAs<base::char16>(), EndAs<base::char16>()));
+  }
   FetchChar();
 }
 
@@ -5,16 +5,22 @@
 #ifndef AOBA_PARSER_UTILS_CHARACTER_READER_H_
 #define AOBA_PARSER_UTILS_CHARACTER_READER_H_
 
+#include <stdint.h>
+
+#include "base/logging.h"
 #include "base/macros.h"
 #include "base/strings/string16.h"
+#include "aoba/base/source_code_range.h"
 
 namespace aoba {
 
 class SourceCode;
-class SourceCodeRange;
 
 namespace parser {
 
+// |CharacterReader| walks a pointer over one byte or two byte contents of
+// source code. |PeekChar()| returns cached current character, which is -1 at
+// end of range as sentinel.
 class CharacterReader final {
  public:
   explicit CharacterReader(const SourceCodeRange& range);
@@ -24,31 +30,125 @@ class CharacterReader final {
   const SourceCodeRange& range() const { return range_; }
   const SourceCode& source_code() const;
 
-  bool CanPeekChar() const;
+  bool CanPeekChar() const { return current_char_ >= 0; }
   base::char16 ConsumeChar();
 
   // Returns true if |PeekChar()| is |expected_char| and advance to next
   // character.
   bool ConsumeCharIf(base::char16 expected_char);
 
+  // Consumes characters while |predicate(char_code)| returns true, and
+  // returns number of consumed characters.
+  template <typename Predicate>
+  int ConsumeWhile(Predicate predicate);
+
   // For handling an RegExp starts with "=".
   void MoveBackward();
 
   // Should be called after |CanPeekChar()|.
   void MoveForward();
 
+  // For re-creating token at |offset|.
+  void MoveTo(int offset);
+
   base::char16 PeekChar() const;
 
+  // Following functions scan characters from current location to end of
+  // range with |aoba/base/character_scanner.h| and return offset of found
+  // character, or end of range if not found.
+
+  // Returns offset of "/" of the first "*/".
+  int FindBlockCommentEnd() const;
+  int FindChar(base::char16 char_code) const;
+  int FindLineTerminator() const;
+
+  // Returns true if there is a line terminator between current location and
+  // |offset|.
+  bool HasLineTerminatorBefore(int offset) const;
+
+  // Moves to the first character other than space and tab.
+  void SkipSpaces();
+
  private:
+  template <typename Char>
+  const Char* CurrentAs() const {
+    return reinterpret_cast<const Char*>(current_);
+  }
+
+  template <typename Char>
+  const Char* EndAs() const {
+    return reinterpret_cast<const Char*>(end_);
+  }
+
+  template <typename Char>
+  const Char* PointerAt(int offset) const {
+    return reinterpret_cast<const Char*>(contents_) + offset;
+  }
+
+  template <typename Char, typename Predicate>
+  void ConsumeWhileInternal(Predicate predicate);
+
   void FetchChar();
+  int OffsetOf(const void* pointer) const;
 
+  // 0 for one byte source code, 1 for two byte source code.
+  const int char_shift_;
+  // Start of contents of |range_.source_code()|.
+  const uint8_t* const contents_;
+  const uint8_t* current_;
   int current_char_ = -1;
-  int current_char_offset_;
-  const SourceCodeRange& range_;
+  // End of |range_| in contents.
+  const uint8_t* const end_;
+  const SourceCodeRange range_;
 
   DISALLOW_COPY_AND_ASSIGN(CharacterReader);
 };
 
+inline base::char16 CharacterReader::ConsumeChar() {
+  const auto result = PeekChar();
+  MoveForward();
+  return result;
+}
+
+template <typename Predicate>
+int CharacterReader::ConsumeWhile(Predicate predicate) {
+  const auto start = current_;
+  if (char_shift_ == 0)
+    ConsumeWhileInternal<uint8_t>(predicate);
+  else
+    ConsumeWhileInternal<base::char16>(predicate);
+  return static_cast<int>((current_ - start) >> char_shift_);
+}
+
+template <typename Char, typename Predicate>
+void CharacterReader::ConsumeWhileInternal(Predicate predicate) {
+  auto* runner = CurrentAs<Char>();
+  auto* const end = EndAs<Char>();
+  while (runner != end && predicate(static_cast<base::char16>(*runner)))
+    ++runner;
+  current_ = reinterpret_cast<const uint8_t*>(runner);
+  FetchChar();
+}
+
+inline void CharacterReader::FetchChar() {
+  if (current_ == end_) {
+    current_char_ = -1;
+    return;
+  }
+  current_char_ = char_shift_ == 0 ? *current_ : *CurrentAs<base::char16>();
+}
+
+inline void CharacterReader::MoveForward() {
+  DCHECK(CanPeekChar());
+  current_ += 1 << char_shift_;
+  FetchChar();
+}
+
+inline base::char16 CharacterReader::PeekChar() const {
+  DCHECK(CanPeekChar());
+  return static_cast<base::char16>(current_char_);
+}
+
 }  // namespace parser
 }  // namespace aoba
 
@@ -0,0 +1,151 @@
+// Copyright (c) 2016 Project Vogue. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <string.h>
+
+#include "aoba/parser/utils/decimal_to_double.h"
+
+#include "base/logging.h"
+#include "base/macros.h"
+
+namespace aoba {
+namespace parser {
+
+namespace {
+
+const int kExponentBias = 1023;
+const int kMaxExponent = 0x7FF;
+const int kSignificandBits = 52;
+
+// Powers of ten which are exactly representable in double.
+const double kExactPowersOfTen[] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+};
+
+int CountLeadingZeros(uint64_t value) {
+  DCHECK_NE(value, 0u);
+  auto count = 0;
+  for (auto shift = 32; shift > 0; shift /= 2) {
+    if (value >> (64 - shift) != 0)
+      continue;
+    count += shift;
+    value <<= shift;
+  }
+  return count;
+}
+
+// Sets high and low 64 bits of |left| * |right|.
+void Multiply(uint64_t left, uint64_t right, uint64_t* high, uint64_t* low) {
+#if defined(__SIZEOF_INT128__)
+  const auto product = static_cast<unsigned __int128>(left) * right;
+  *high = static_cast<uint64_t>(product >> 64);
+  *low = static_cast<uint64_t>(product);
+#else
+  const auto left_high = left >> 32;
+  const auto left_low = left & 0xFFFFFFFF;
+  const auto right_high = right >> 32;
+  const auto right_low = right & 0xFFFFFFFF;
+  const auto low_low = left_low * right_low;
+  const auto high_low = left_high * right_low;
+  const auto middle =
+      (low_low >> 32) + (high_low & 0xFFFFFFFF) + left_low * right_high;
+  *high = left_high * right_high + (high_low >> 32) + (middle >> 32);
+  *low = (middle << 32) | (low_low & 0xFFFFFFFF);
+#endif
+}
+
+// Clinger's fast path: both |significand| and power of ten are exact in
+// double, so one multiplication or division rounds correctly.
+bool ExactDecimalToDouble(uint64_t significand, int exponent, double* result) {
+  const auto kMaxExactInteger = static_cast<uint64_t>(1) << 53;
+  const auto kMaxExactPower = static_cast<int>(arraysize(kExactPowersOfTen));
+  if (significand > kMaxExactInteger || exponent <= -kMaxExactPower ||
+      exponent >= kMaxExactPower) {
+    return false;
+  }
+  const auto value = static_cast<double>(significand);
+  if (exponent >= 0)
+    *result = value * kExactPowersOfTen[exponent];
+  else
+    *result = value / kExactPowersOfTen[-exponent];
+  return true;
+}
+
+// Eisel-Lemire algorithm: multiplies |significand| by 128-bit approximation
+// of power of ten, and uses the product if truncated bits can't change
+// rounding.
+bool EiselLemire(uint64_t significand, int exponent, double* result) {
+  if (exponent < internal::kMinPowerOfTen ||
+      exponent > internal::kMaxPowerOfTen) {
+    return false;
+  }
+  const auto& power =
+      internal::kPowerOfTenTable[exponent - internal::kMinPowerOfTen];
+  const auto leading_zeros = CountLeadingZeros(significand);
+  const auto normalized = significand << leading_zeros;
+  // 217706 / 2^16 approximates log2(10) enough for |kPowerOfTenTable|.
+  auto binary_exponent = ((217706 * exponent) >> 16) + 64 + kExponentBias -
+                         leading_zeros;
+
+  uint64_t high;
+  uint64_t low;
+  Multiply(normalized, power[0], &high, &low);
+  if ((high & 0x1FF) == 0x1FF && low + normalized < normalized) {
+    // Lower 64 bits of power of ten may carry into |high|.
+    uint64_t carry_high;
+    uint64_t carry_low;
+    Multiply(normalized, power[1], &carry_high, &carry_low);
+    const auto merged_low = low + carry_high;
+    const auto merged_high = high + (merged_low < low ? 1 : 0);
+    if ((merged_high & 0x1FF) == 0x1FF && merged_low + 1 == 0 &&
+        carry_low + normalized < normalized) {
+      return false;
+    }
+    high = merged_high;
+    low = merged_low;
+  }
+
+  const auto upper_bit = static_cast<int>(high >> 63);
+  auto mantissa = high >> (upper_bit + 9);
+  binary_exponent -= 1 ^ upper_bit;
+
+  // Product may be exactly halfway between two doubles.
+  if (low == 0 && (high & 0x1FF) == 0 && (mantissa & 3) == 1)
+    return false;
+
+  // Round half to even from 54 bits to 53 bits.
+  mantissa += mantissa & 1;
+  mantissa >>= 1;
+  if (mantissa >> (kSignificandBits + 1) != 0) {
+    mantissa >>= 1;
+    ++binary_exponent;
+  }
+  if (binary_exponent <= 0 || binary_exponent >= kMaxExponent)
+    return false;
+
+  const auto kSignificandMask =
+      (static_cast<uint64_t>(1) << kSignificandBits) - 1;
+  const auto bits =
+      static_cast<uint64_t>(binary_exponent) << kSignificandBits |
+      (mantissa & kSignificandMask);
+  static_assert(sizeof(bits) == sizeof(*result), "Should be same size");
+  ::memcpy(result, &bits, sizeof(bits));
+  return true;
+}
+
+}  // namespace
+
+bool DecimalToDouble(uint64_t significand, int exponent, double* result) {
+  if (significand == 0) {
+    *result = 0;
+    return true;
+  }
+  if (ExactDecimalToDouble(significand, exponent, result))
+    return true;
+  return EiselLemire(significand, exponent, result);
+}
+
+}  // namespace parser
+}  // namespace aoba
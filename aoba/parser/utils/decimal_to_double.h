@@ -0,0 +1,34 @@
+// Copyright (c) 2016 Project Vogue. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef AOBA_PARSER_UTILS_DECIMAL_TO_DOUBLE_H_
+#define AOBA_PARSER_UTILS_DECIMAL_TO_DOUBLE_H_
+
+#include <stdint.h>
+
+namespace aoba {
+namespace parser {
+
+namespace internal {
+
+const int kMinPowerOfTen = -342;
+const int kMaxPowerOfTen = 308;
+
+// Normalized 128-bit significands of 10^-342 to 10^308 in high and low
+// order, generated by "make_power_of_ten_table.py".
+extern const uint64_t kPowerOfTenTable[kMaxPowerOfTen - kMinPowerOfTen + 1][2];
+
+}  // namespace internal
+
+// Sets correctly rounded |significand| * 10^|exponent| to |result| and
+// returns true. Returns false if result is too close to halfway between two
+// doubles, subnormal or out of range, then caller should use arbitrary
+// precision conversion. We use Clinger's fast path and Eisel-Lemire
+// algorithm.
+bool DecimalToDouble(uint64_t significand, int exponent, double* result);
+
+}  // namespace parser
+}  // namespace aoba
+
+#endif  // AOBA_PARSER_UTILS_DECIMAL_TO_DOUBLE_H_
@@ -5,6 +5,8 @@
 #ifndef AOBA_PARSER_UTILS_LEXER_UTILS_H_
 #define AOBA_PARSER_UTILS_LEXER_UTILS_H_
 
+#include <stdint.h>
+
 #include "base/logging.h"
 #include "base/strings/string16.h"
 
@@ -24,25 +26,76 @@ constexpr auto kParagraphSeparator = 0x2029;
 constexpr auto kZeroWidthNoBreakSpace = 0xFEFF;  // aka BOM, byte order mark
 constexpr auto kMaxUnicodeCodePoint = 0x10FFFF;
 
+namespace internal {
+
+enum CharacterClass {
+  kIdentifierStart = 1 << 0,
+  kIdentifierPart = 1 << 1,
+  kWhitespace = 1 << 2,
+  kLineTerminator = 1 << 3,
+  kHexDigit = 1 << 4,
+};
+
+const int kCharacterClassBlockSize = 64;
+
+// Character class tables are generated by "make_character_tables.py".
+// Classes of non-ASCII characters are looked up by two level trie, which
+// maps upper 10 bits of |char_code| to a block of 64 classes.
+extern const uint8_t kAsciiCharacterClasses[128];
+extern const uint8_t kCharacterClassIndexes[1024];
+extern const uint8_t kCharacterClassBlocks[][kCharacterClassBlockSize];
+
+inline int CharacterClassOf(base::char16 char_code) {
+  if (char_code < 128)
+    return kAsciiCharacterClasses[char_code];
+  return kCharacterClassBlocks[kCharacterClassIndexes[char_code >> 6]]
+                              [char_code & (kCharacterClassBlockSize - 1)];
+}
+
+}  // namespace internal
+
 // Returns a digit from digit character |char_code| in |base|. It is error
 // if |char_code| is not valid digit character.
 int FromDigitChar(base::char16 char_code, int base);
 
 // Returns true if |char_code| reprsents a digit of |base|. |base| >= 2 &&
 // |base| <= 16.
-bool IsDigitChar(base::char16 char_code, int base);
+inline bool IsDigitChar(base::char16 char_code, int base) {
+  DCHECK_GE(base, 2);
+  DCHECK_LE(base, 16);
+  if (base == 16) {
+    return char_code < 128 &&
+           (internal::kAsciiCharacterClasses[char_code] &
+            internal::kHexDigit) != 0;
+  }
+  return char_code >= '0' && char_code <= '0' + base - 1;
+}
 
-// Returns true if |char_code| is valid for ECMAScript identifier part.
-bool IsIdentifierPart(base::char16 char_code);
+// Returns true if |char_code| is valid for ECMAScript identifier part, e.g.
+// Unicode ID_Continue, '$', <ZWNJ> and <ZWJ>.
+inline bool IsIdentifierPart(base::char16 char_code) {
+  return (internal::CharacterClassOf(char_code) &
+          internal::kIdentifierPart) != 0;
+}
 
-// Returns true if |char_code| is valid for ECMAScript identifier start.
-bool IsIdentifierStart(base::char16 char_code);
+// Returns true if |char_code| is valid for ECMAScript identifier start, e.g.
+// Unicode ID_Start, '$' and '_'.
+inline bool IsIdentifierStart(base::char16 char_code) {
+  return (internal::CharacterClassOf(char_code) &
+          internal::kIdentifierStart) != 0;
+}
 
 // Returns true if |char_code| is a line terminator of ECMAScript.
-bool IsLineTerminator(base::char16 char_code);
+inline bool IsLineTerminator(base::char16 char_code) {
+  return (internal::CharacterClassOf(char_code) &
+          internal::kLineTerminator) != 0;
+}
 
-// Returns true if |char_code| is a whitespace of ECMAScript.
-bool IsWhitespace(base::char16 char_code);
+// Returns true if |char_code| is a whitespace or a line terminator of
+// ECMAScript.
+inline bool IsWhitespace(base::char16 char_code) {
+  return (internal::CharacterClassOf(char_code) & internal::kWhitespace) != 0;
+}
 
 }  // namespace parser
 }  // namespace aoba
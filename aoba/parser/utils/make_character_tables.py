@@ -0,0 +1,162 @@
+#!/usr/bin/env python
+# Copyright (c) 2016 Project Vogue. All rights reserved.
+# Use of this source code is governed by a BSD-style license that can be
+# found in the LICENSE file.
+
+"""Generates character class tables used by "lexer_utils.h".
+
+Classes of non-ASCII characters come from "unicode_data.txt", which is
+extracted from the Unicode character database, rather than from the database
+of the Python running this script, to generate the same tables on every build
+machine.
+"""
+
+import os
+import re
+import sys
+
+# Keep these values in sync with |internal::CharacterClass| in
+# "lexer_utils.h".
+IDENTIFIER_START = 1
+IDENTIFIER_PART = 2
+WHITESPACE = 4
+LINE_TERMINATOR = 8
+HEX_DIGIT = 16
+
+ASCII_SIZE = 128
+BLOCK_SIZE = 64
+NUMBER_OF_CODE_UNITS = 0x10000
+
+LINE_TERMINATORS = [0x000A, 0x000D, 0x2028, 0x2029]
+
+# ECMAScript WhiteSpace other than category Zs.
+WHITESPACES = [0x0009, 0x000B, 0x000C, 0xFEFF]
+
+ZWNJ = 0x200C
+ZWJ = 0x200D
+
+
+def load_unicode_data(file_name):
+    """Returns Unicode version and a map from property to set of code units
+    in the Basic Multilingual Plane."""
+    version = None
+    properties = {}
+    with open(file_name, 'rt') as data_file:
+        for line in data_file:
+            matches = re.match(r'#\s*Version:\s*(\S+)', line)
+            if matches:
+                version = matches.group(1)
+                continue
+            line = line.split('#', 1)[0].strip()
+            if not line:
+                continue
+            code_points, name = [field.strip() for field in line.split(';')]
+            bounds = code_points.split('..')
+            start = int(bounds[0], 16)
+            end = int(bounds[-1], 16)
+            code_units = properties.setdefault(name, set())
+            for code_point in range(start, min(end + 1, NUMBER_OF_CODE_UNITS)):
+                code_units.add(code_point)
+    assert version, 'No version in %s' % file_name
+    return version, properties
+
+
+def class_of(code_unit, properties):
+    if code_unit in LINE_TERMINATORS:
+        return WHITESPACE | LINE_TERMINATOR
+    if code_unit in WHITESPACES:
+        return WHITESPACE
+    if 0xD800 <= code_unit <= 0xDFFF:
+        # Lexers work on UTF-16 code units. We accept surrogates as
+        # identifier characters to allow non-BMP identifiers.
+        return IDENTIFIER_START | IDENTIFIER_PART
+    if code_unit in [ord('$'), ord('_')]:
+        return IDENTIFIER_START | IDENTIFIER_PART
+    if code_unit in [ZWNJ, ZWJ]:
+        return IDENTIFIER_PART
+    if code_unit in properties['Zs']:
+        return WHITESPACE
+    result = 0
+    if code_unit < ASCII_SIZE and chr(code_unit) in '0123456789ABCDEFabcdef':
+        result |= HEX_DIGIT
+    if code_unit in properties['ID_Start']:
+        return result | IDENTIFIER_START | IDENTIFIER_PART
+    if code_unit in properties['ID_Continue']:
+        return result | IDENTIFIER_PART
+    return result
+
+
+def format_values(values, indent):
+    lines = []
+    for start in range(0, len(values), 16):
+        lines += [indent + ', '.join(
+            ['%d' % value for value in values[start:start + 16]]) + ',']
+    return lines
+
+
+def generate_cc_file(output_file_name, unicode_data_file_name):
+    version, properties = load_unicode_data(unicode_data_file_name)
+    classes = [class_of(code_unit, properties)
+               for code_unit in range(NUMBER_OF_CODE_UNITS)]
+
+    blocks = []
+    block_index_map = {}
+    indexes = []
+    for start in range(0, NUMBER_OF_CODE_UNITS, BLOCK_SIZE):
+        block = tuple(classes[start:start + BLOCK_SIZE])
+        if block not in block_index_map:
+            block_index_map[block] = len(blocks)
+            blocks.append(block)
+        indexes.append(block_index_map[block])
+    assert len(blocks) <= 256, 'Too many blocks %d' % len(blocks)
+
+    lines = [
+        '// Generated by %s. Do not edit.' % os.path.basename(sys.argv[0]),
+        '// Unicode %s' % version,
+        '',
+        '#include "aoba/parser/utils/lexer_utils.h"',
+        '',
+        'namespace aoba {',
+        'namespace parser {',
+        'namespace internal {',
+        '',
+        'const uint8_t kAsciiCharacterClasses[%d] = {' % ASCII_SIZE,
+    ]
+    lines += format_values(classes[:ASCII_SIZE], '    ')
+    lines += [
+        '};',
+        '',
+        'const uint8_t kCharacterClassIndexes[%d] = {' % len(indexes),
+    ]
+    lines += format_values(indexes, '    ')
+    lines += [
+        '};',
+        '',
+        'const uint8_t kCharacterClassBlocks[%d][%d] = {' % (len(blocks),
+                                                             BLOCK_SIZE),
+    ]
+    for block in blocks:
+        lines += ['    {']
+        lines += format_values(list(block), '        ')
+        lines += ['    },']
+    lines += [
+        '};',
+        '',
+        '}  // namespace internal',
+        '}  // namespace parser',
+        '}  // namespace aoba',
+        '',
+    ]
+    with open(output_file_name, 'wt') as output:
+        output.write('\n'.join(lines))
+
+
+def main():
+    if len(sys.argv) != 3:
+        sys.stderr.write('Usage: %s unicode_data output_file\n' % sys.argv[0])
+        return 1
+    generate_cc_file(sys.argv[2], sys.argv[1])
+    return 0
+
+if __name__ == "__main__":
+    sys.exit(main())
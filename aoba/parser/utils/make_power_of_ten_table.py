@@ -0,0 +1,76 @@
+#!/usr/bin/env python
+# Copyright (c) 2016 Project Vogue. All rights reserved.
+# Use of this source code is governed by a BSD-style license that can be
+# found in the LICENSE file.
+
+"""Generates 128-bit approximations of powers of ten used by
+"decimal_to_double.h".
+"""
+
+import os
+import sys
+
+# Keep these values in sync with "decimal_to_double.h".
+MIN_EXPONENT = -342
+MAX_EXPONENT = 308
+
+MASK64 = (1 << 64) - 1
+
+
+def significand_of(exponent):
+    """Returns normalized 128-bit significand of 10**exponent. Significands of
+    positive powers are truncated and ones of negative powers are rounded up.
+    """
+    if exponent >= 0:
+        value = 10 ** exponent
+        length = value.bit_length()
+        if length > 128:
+            return value >> (length - 128)
+        return value << (128 - length)
+    divisor = 10 ** -exponent
+    shift = 127 + divisor.bit_length()
+    value = (1 << shift) // divisor
+    while value.bit_length() < 128:
+        shift += 1
+        value = (1 << shift) // divisor
+    return value + 1
+
+
+def generate_cc_file(output_file_name):
+    lines = [
+        '// Generated by %s. Do not edit.' % os.path.basename(sys.argv[0]),
+        '',
+        '#include "aoba/parser/utils/decimal_to_double.h"',
+        '',
+        'namespace aoba {',
+        'namespace parser {',
+        'namespace internal {',
+        '',
+        'const uint64_t kPowerOfTenTable[%d][2] = {' % (
+            MAX_EXPONENT - MIN_EXPONENT + 1),
+    ]
+    for exponent in range(MIN_EXPONENT, MAX_EXPONENT + 1):
+        value = significand_of(exponent)
+        lines += ['    {0x%016XULL, 0x%016XULL},  // 1e%d' % (
+            value >> 64, value & MASK64, exponent)]
+    lines += [
+        '};',
+        '',
+        '}  // namespace internal',
+        '}  // namespace parser',
+        '}  // namespace aoba',
+        '',
+    ]
+    with open(output_file_name, 'wt') as output:
+        output.write('\n'.join(lines))
+
+
+def main():
+    if len(sys.argv) != 2:
+        sys.stderr.write('Usage: %s output_file\n' % sys.argv[0])
+        return 1
+    generate_cc_file(sys.argv[1])
+    return 0
+
+if __name__ == "__main__":
+    sys.exit(main())
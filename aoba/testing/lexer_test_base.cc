@@ -4,7 +4,6 @@
 
 #include "aoba/testing/lexer_test_base.h"
 
-#include "base/strings/utf_string_conversions.h"
 #include "aoba/base/source_code_factory.h"
 #include "aoba/parser/public/parser_context.h"
 #include "aoba/parser/public/parser_context_builder.h"
@@ -23,9 +22,8 @@ LexerTestBase::LexerTestBase()
       source_code_factory_(&zone_) {}
 
 void LexerTestBase::PrepareSouceCode(base::StringPiece script_text) {
-  const auto& script_text16 = base::UTF8ToUTF16(script_text);
-  source_code_ = &source_code_factory_.New(base::FilePath(),
-                                           base::StringPiece16(script_text16));
+  source_code_ =
+      &source_code_factory_.NewFromUtf8(base::FilePath(), script_text);
   error_sink_.Reset();
 }
 
@@ -80,7 +80,8 @@ UsingSourceCode SourceCodeOf(const ast::Node& node) {
 std::ostream& operator<<(std::ostream& ostream,
                          const UsingSourceCode& printable) {
   const auto& node = *printable.node;
-  return ostream << base::UTF16ToUTF8(node.range().GetString());
+  base::string16 buffer;
+  return ostream << base::UTF16ToUTF8(node.range().GetString(&buffer));
 }
 
 // Dispatcher